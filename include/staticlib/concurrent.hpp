@@ -24,14 +24,44 @@
 #ifndef STATICLIB_CONCURRENT_HPP
 #define STATICLIB_CONCURRENT_HPP
 
+#include "staticlib/concurrent/async_queue.hpp"
+#include "staticlib/concurrent/atomic_wait.hpp"
+#include "staticlib/concurrent/blocking_stack.hpp"
+#include "staticlib/concurrent/channel.hpp"
+#include "staticlib/concurrent/combining_blocking_queue.hpp"
 #include "staticlib/concurrent/condition_latch.hpp"
+#include "staticlib/concurrent/conflating_queue.hpp"
 #include "staticlib/concurrent/countdown_latch.hpp"
+#include "staticlib/concurrent/cyclic_barrier.hpp"
+#include "staticlib/concurrent/dedup_blocking_queue.hpp"
+#include "staticlib/concurrent/delay_queue.hpp"
+#include "staticlib/concurrent/distributed_shared_mutex.hpp"
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/fork_join_pool.hpp"
 #include "staticlib/concurrent/growing_buffer.hpp"
+#include "staticlib/concurrent/inplace_task.hpp"
+#include "staticlib/concurrent/mcs_mutex.hpp"
+#include "staticlib/concurrent/memory_reclamation.hpp"
 #include "staticlib/concurrent/mpmc_blocking_queue.hpp"
+#include "staticlib/concurrent/phaser.hpp"
+#include "staticlib/concurrent/priority_blocking_queue.hpp"
+#include "staticlib/concurrent/rcu_cell.hpp"
+#include "staticlib/concurrent/readiness_notifier.hpp"
+#include "staticlib/concurrent/reorder_buffer.hpp"
+#include "staticlib/concurrent/semaphore.hpp"
+#include "staticlib/concurrent/seqlock_cell.hpp"
+#include "staticlib/concurrent/spin_mutex.hpp"
 #include "staticlib/concurrent/spsc_concurrent_queue.hpp"
 #include "staticlib/concurrent/spsc_inobject_concurrent_queue.hpp"
 #include "staticlib/concurrent/spsc_inobject_waiting_queue.hpp"
 #include "staticlib/concurrent/spsc_waiting_queue.hpp"
+#include "staticlib/concurrent/synchronous_queue.hpp"
+#include "staticlib/concurrent/task_queue.hpp"
+#include "staticlib/concurrent/thread_pool_executor.hpp"
+#include "staticlib/concurrent/ticket_mutex.hpp"
+#include "staticlib/concurrent/triple_buffer.hpp"
+#include "staticlib/concurrent/wait_group.hpp"
+#include "staticlib/concurrent/work_stealing_deque.hpp"
 
 // export namespace with shorter name
 namespace sl = staticlib;
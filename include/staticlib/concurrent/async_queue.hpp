@@ -0,0 +1,469 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 7:30 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_ASYNC_QUEUE_HPP
+#define STATICLIB_CONCURRENT_ASYNC_QUEUE_HPP
+
+// available only with C++20 coroutines support
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <cstdint>
+#include <coroutine>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_async_queue {
+
+// lives in the frame of the suspended coroutine
+class waiter_node {
+public:
+    waiter_node* next = nullptr;
+    std::coroutine_handle<> handle;
+    void (*schedule)(void* executor, std::coroutine_handle<> handle) = nullptr;
+    void* executor = nullptr;
+    bool success = false;
+
+    void resume() {
+        if (nullptr != schedule) {
+            schedule(executor, handle);
+        } else {
+            handle.resume();
+        }
+    }
+};
+
+class waiter_list {
+public:
+    waiter_node* head = nullptr;
+    waiter_node* tail = nullptr;
+
+    bool empty() const {
+        return nullptr == head;
+    }
+
+    void push_back(waiter_node* node) {
+        node->next = nullptr;
+        if (nullptr != tail) {
+            tail->next = node;
+        } else {
+            head = node;
+        }
+        tail = node;
+    }
+
+    waiter_node* pop_front() {
+        waiter_node* node = head;
+        head = node->next;
+        if (nullptr == head) {
+            tail = nullptr;
+        }
+        node->next = nullptr;
+        return node;
+    }
+
+    // nodes are resumed outside of the queue lock
+    void resume_all() {
+        while (!empty()) {
+            pop_front()->resume();
+        }
+    }
+};
+
+template<typename Executor>
+void schedule_on(void* executor, std::coroutine_handle<> handle) {
+    bool accepted = false;
+    try {
+        accepted = static_cast<Executor*> (executor)->execute([handle] { handle.resume(); });
+    } catch (...) {
+        // task allocation failed, handled the same way as rejection
+    }
+    if (!accepted) {
+        // rejected by executor, coroutine must not be lost
+        handle.resume();
+    }
+}
+
+} // namespace
+
+/**
+ * Optionally bounded FIFO queue for coroutines, `co_await queue.async_take()`
+ * suspends the calling coroutine until an element is available and
+ * `co_await queue.async_put(value)` suspends it until there is space
+ * in the bounded queue, OS threads are never blocked. Suspended coroutines
+ * are kept in intrusive lists of nodes that live in their own frames, elements
+ * are handed over directly to the suspended coroutine before it is resumed.
+ * Coroutines are resumed inline in the notifying thread, or on the specified
+ * executor, any type with `bool execute(Func)` method (like `thread_pool_executor`).
+ * Available only when compiler supports coroutines.
+ */
+template<typename T>
+class async_queue : public std::enable_shared_from_this<async_queue<T>> {
+    using waiter_node = detail_async_queue::waiter_node;
+    using waiter_list = detail_async_queue::waiter_list;
+
+    class take_node : public waiter_node {
+    public:
+        std::optional<T> result;
+    };
+
+    class put_node : public waiter_node {
+    public:
+        std::optional<T> value;
+    };
+
+    mutable std::mutex mutex;
+    std::deque<T> queue;
+    waiter_list takers;
+    waiter_list putters;
+    const size_t max_queue_size;
+    bool unblocked = false;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Awaitable returned by `async_take`, resumes with
+     * empty optional if the queue was unblocked
+     */
+    class take_awaiter {
+        friend class async_queue;
+
+        async_queue& queue;
+        take_node node;
+
+        take_awaiter(async_queue& queue, void (*schedule)(void*, std::coroutine_handle<>), void* executor) :
+        queue(queue) {
+            node.schedule = schedule;
+            node.executor = executor;
+        }
+
+    public:
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            node.handle = handle;
+            return queue.suspend_take(node);
+        }
+
+        std::optional<T> await_resume() {
+            return std::move(node.result);
+        }
+    };
+
+    /**
+     * Awaitable returned by `async_put`, resumes with
+     * false if the queue was unblocked
+     */
+    class put_awaiter {
+        friend class async_queue;
+
+        async_queue& queue;
+        put_node node;
+
+        put_awaiter(async_queue& queue, T&& value, void (*schedule)(void*, std::coroutine_handle<>),
+                void* executor) :
+        queue(queue) {
+            node.value.emplace(std::move(value));
+            node.schedule = schedule;
+            node.executor = executor;
+        }
+
+    public:
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            node.handle = handle;
+            return queue.suspend_put(node);
+        }
+
+        bool await_resume() {
+            return node.success;
+        }
+    };
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of elements in the queue,
+     *        zero value (supplied by default) means unbounded queue
+     */
+    explicit async_queue(size_t max_queue_size = 0) :
+    max_queue_size(max_queue_size) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    async_queue(const async_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    async_queue& operator=(const async_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    async_queue(async_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    async_queue& operator=(async_queue&&) = delete;
+
+    /**
+     * Awaitable take operation, suspended coroutine is resumed
+     * inline by the thread that puts the element
+     *
+     * @return awaitable that resumes with the element,
+     *         or with empty optional if the queue was unblocked
+     */
+    take_awaiter async_take() {
+        return take_awaiter(*this, nullptr, nullptr);
+    }
+
+    /**
+     * Awaitable take operation, suspended coroutine is resumed
+     * on the specified executor
+     *
+     * @param executor executor to resume the coroutine on, must outlive the operation
+     * @return awaitable that resumes with the element,
+     *         or with empty optional if the queue was unblocked
+     */
+    template<typename Executor>
+    take_awaiter async_take(Executor& executor) {
+        return take_awaiter(*this, detail_async_queue::schedule_on<Executor>, std::addressof(executor));
+    }
+
+    /**
+     * Awaitable put operation, suspended coroutine is resumed
+     * inline by the thread that frees the space in the queue
+     *
+     * @param value element to put
+     * @return awaitable that resumes with false if the queue was unblocked, true otherwise
+     */
+    put_awaiter async_put(T value) {
+        return put_awaiter(*this, std::move(value), nullptr, nullptr);
+    }
+
+    /**
+     * Awaitable put operation, suspended coroutine is resumed
+     * on the specified executor
+     *
+     * @param value element to put
+     * @param executor executor to resume the coroutine on, must outlive the operation
+     * @return awaitable that resumes with false if the queue was unblocked, true otherwise
+     */
+    template<typename Executor>
+    put_awaiter async_put(T value, Executor& executor) {
+        return put_awaiter(*this, std::move(value), detail_async_queue::schedule_on<Executor>,
+                std::addressof(executor));
+    }
+
+    /**
+     * Emplace a value at the end of the queue, or hand it over
+     * to a suspended taker. This method returns immediately.
+     *
+     * @param record_args constructor arguments for queue element
+     * @return false if the queue was full, true otherwise
+     */
+    template<typename ...Args>
+    bool emplace(Args&&... record_args) {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            if (!takers.empty()) {
+                // taker stays queued if the constructor throws
+                take_node* taker = static_cast<take_node*> (takers.head);
+                taker->result.emplace(std::forward<Args>(record_args)...);
+                takers.pop_front();
+                taker->success = true;
+                ready.push_back(taker);
+            } else if (0 == max_queue_size || queue.size() < max_queue_size) {
+                queue.emplace_back(std::forward<Args>(record_args)...);
+            } else {
+                return false;
+            }
+        }
+        ready.resume_all();
+        return true;
+    }
+
+    /**
+     * Attempt to read the value at the front to the queue into a variable.
+     * This method returns immediately.
+     *
+     * @param record move the value at the front of the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(T& record) {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            if (queue.empty()) {
+                return false;
+            }
+            record = std::move(queue.front());
+            queue.pop_front();
+            admit_putter(ready);
+        }
+        ready.resume_all();
+        return true;
+    }
+
+    /**
+     * Unblocks the queue, suspended takers and putters are resumed
+     * with failure, queue cannot be used for waiting after this call.
+     */
+    void unblock() {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            unblocked = true;
+            while (!takers.empty()) {
+                ready.push_back(takers.pop_front());
+            }
+            while (!putters.empty()) {
+                ready.push_back(putters.pop_front());
+            }
+        }
+        ready.resume_all();
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return unblocked;
+    }
+
+    /**
+     * Check if the queue is empty
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return queue.empty();
+    }
+
+    /**
+     * Returns the number of entries in the queue
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return queue.size();
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+private:
+    // returns false if the coroutine must not be suspended
+    bool suspend_take(take_node& node) {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            if (!queue.empty()) {
+                node.result.emplace(std::move(queue.front()));
+                node.success = true;
+                queue.pop_front();
+                admit_putter(ready);
+            } else if (unblocked) {
+                return false;
+            } else {
+                takers.push_back(std::addressof(node));
+                return true;
+            }
+        }
+        ready.resume_all();
+        return false;
+    }
+
+    bool suspend_put(put_node& node) {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            if (unblocked) {
+                return false;
+            }
+            if (!takers.empty()) {
+                take_node* taker = static_cast<take_node*> (takers.head);
+                taker->result = std::move(node.value);
+                takers.pop_front();
+                taker->success = true;
+                ready.push_back(taker);
+            } else if (0 == max_queue_size || queue.size() < max_queue_size) {
+                queue.emplace_back(std::move(*node.value));
+            } else {
+                putters.push_back(std::addressof(node));
+                return true;
+            }
+            node.success = true;
+        }
+        ready.resume_all();
+        return false;
+    }
+
+    void admit_putter(waiter_list& ready) {
+        if (putters.empty()) {
+            return;
+        }
+        put_node* putter = static_cast<put_node*> (putters.head);
+        queue.emplace_back(std::move(*putter->value));
+        putters.pop_front();
+        putter->success = true;
+        ready.push_back(putter);
+    }
+
+};
+
+} // namespace
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif /* STATICLIB_CONCURRENT_ASYNC_QUEUE_HPP */
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   atomic_wait.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:15 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_ATOMIC_WAIT_HPP
+#define STATICLIB_CONCURRENT_ATOMIC_WAIT_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <type_traits>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else // !__linux__
+#include <condition_variable>
+#include <mutex>
+#endif // __linux__
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_atomic_wait {
+
+#ifdef __linux__
+
+// futex word is always 32-bit, 64-bit values are waited on their low half
+template<typename T>
+uint32_t* futex_word(const std::atomic<T>& atom) {
+    static_assert(sizeof (std::atomic<T>) == sizeof (T), "Invalid atomic size");
+    static_assert(4 == sizeof (T) || 8 == sizeof (T), "Only 32-bit and 64-bit values are supported");
+    uint32_t* ptr = reinterpret_cast<uint32_t*> (const_cast<std::atomic<T>*> (std::addressof(atom)));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (8 == sizeof (T)) {
+        ptr += 1;
+    }
+#endif // big endian
+    return ptr;
+}
+
+template<typename T>
+uint32_t futex_value(T value) {
+    return static_cast<uint32_t> (static_cast<uint64_t> (value) & 0xFFFFFFFF);
+}
+
+inline void futex_wait(uint32_t* word, uint32_t expected, struct timespec* timeout) {
+    // EINTR, EAGAIN and ETIMEDOUT are handled by callers re-checking the value
+    ::syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+inline void futex_wake(uint32_t* word, int count) {
+    ::syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+#else // !__linux__
+
+class wait_slot {
+public:
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// process-wide table, notifiers must not touch the waited object
+template<typename Tag = void>
+class wait_table {
+public:
+    static const size_t slots_count = 32;
+
+    static wait_slot slots[slots_count];
+
+    static wait_slot& slot_for(const void* addr) {
+        size_t hash = reinterpret_cast<size_t> (addr);
+        hash ^= (hash >> 4) ^ (hash >> 12);
+        return slots[hash % slots_count];
+    }
+};
+
+template<typename Tag>
+const size_t wait_table<Tag>::slots_count;
+
+template<typename Tag>
+wait_slot wait_table<Tag>::slots[wait_table<Tag>::slots_count];
+
+#endif // __linux__
+
+} // namespace
+
+/**
+ * Blocks until the value of the specified atomic will differ from
+ * the `old` one, change must be followed by `atomic_notify_one` or
+ * `atomic_notify_all` call. Similar to C++20 `std::atomic::wait`,
+ * uses futex on Linux and a process-wide table of mutexes
+ * with condition variables on other platforms.
+ *
+ * @param atom atomic variable
+ * @param old value to wait a change from
+ */
+template<typename T>
+void atomic_wait(const std::atomic<T>& atom, T old) {
+    static_assert(std::is_integral<T>::value, "Only integral values are supported");
+#ifdef __linux__
+    uint32_t* word = detail_atomic_wait::futex_word(atom);
+    while (old == atom.load(std::memory_order_acquire)) {
+        detail_atomic_wait::futex_wait(word, detail_atomic_wait::futex_value(old), nullptr);
+    }
+#else // !__linux__
+    auto& slot = detail_atomic_wait::wait_table<>::slot_for(std::addressof(atom));
+    std::unique_lock<std::mutex> guard{slot.mutex};
+    while (old == atom.load(std::memory_order_acquire)) {
+        slot.cv.wait(guard);
+    }
+#endif // __linux__
+}
+
+/**
+ * Blocks until the value of the specified atomic will differ from
+ * the `old` one or until deadline is reached
+ *
+ * @param atom atomic variable
+ * @param old value to wait a change from
+ * @param deadline time point to wait until
+ * @return false if exit on deadline, true otherwise
+ */
+template<typename T>
+bool atomic_wait_until(const std::atomic<T>& atom, T old,
+        const std::chrono::steady_clock::time_point& deadline) {
+    static_assert(std::is_integral<T>::value, "Only integral values are supported");
+#ifdef __linux__
+    uint32_t* word = detail_atomic_wait::futex_word(atom);
+    while (old == atom.load(std::memory_order_acquire)) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t> (nanos / 1000000000);
+        ts.tv_nsec = static_cast<long> (nanos % 1000000000);
+        detail_atomic_wait::futex_wait(word, detail_atomic_wait::futex_value(old), std::addressof(ts));
+    }
+    return true;
+#else // !__linux__
+    auto& slot = detail_atomic_wait::wait_table<>::slot_for(std::addressof(atom));
+    std::unique_lock<std::mutex> guard{slot.mutex};
+    while (old == atom.load(std::memory_order_acquire)) {
+        if (std::cv_status::timeout == slot.cv.wait_until(guard, deadline)) {
+            return old != atom.load(std::memory_order_acquire);
+        }
+    }
+    return true;
+#endif // __linux__
+}
+
+/**
+ * Wakes one of the threads blocked in `atomic_wait` on the specified
+ * atomic. Atomic variable itself is not accessed, so it can be destroyed
+ * by a waiter concurrently with this call.
+ *
+ * @param atom atomic variable
+ */
+template<typename T>
+void atomic_notify_one(std::atomic<T>& atom) {
+#ifdef __linux__
+    detail_atomic_wait::futex_wake(detail_atomic_wait::futex_word(atom), 1);
+#else // !__linux__
+    // table slots are shared between variables, so everybody is woken
+    auto& slot = detail_atomic_wait::wait_table<>::slot_for(std::addressof(atom));
+    {
+        std::lock_guard<std::mutex> guard{slot.mutex};
+    }
+    slot.cv.notify_all();
+#endif // __linux__
+}
+
+/**
+ * Wakes all the threads blocked in `atomic_wait` on the specified
+ * atomic. Atomic variable itself is not accessed, so it can be destroyed
+ * by a waiter concurrently with this call.
+ *
+ * @param atom atomic variable
+ */
+template<typename T>
+void atomic_notify_all(std::atomic<T>& atom) {
+#ifdef __linux__
+    detail_atomic_wait::futex_wake(detail_atomic_wait::futex_word(atom), INT_MAX);
+#else // !__linux__
+    auto& slot = detail_atomic_wait::wait_table<>::slot_for(std::addressof(atom));
+    {
+        std::lock_guard<std::mutex> guard{slot.mutex};
+    }
+    slot.cv.notify_all();
+#endif // __linux__
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_ATOMIC_WAIT_HPP */
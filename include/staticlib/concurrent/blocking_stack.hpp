@@ -0,0 +1,439 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   blocking_stack.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:40 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_BLOCKING_STACK_HPP
+#define STATICLIB_CONCURRENT_BLOCKING_STACK_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+// based on: "A Scalable Lock-free Stack Algorithm", Hendler, Shavit, Yerushalmi, SPAA 2004
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Bounded lock-free LIFO stack with elimination backoff and with
+ * optional blocking `take` operation. Nodes are preallocated on
+ * construction, stack links are tagged node indices, so neither
+ * `emplace` nor `poll` allocate. Producers and consumers that collide
+ * on the top of the stack exchange elements through the elimination
+ * array without touching the top. Elimination slot is chosen randomly
+ * on each attempt from the range that grows on collisions in the array
+ * and shrinks when offers time out without a partner.
+ */
+template<typename T>
+class blocking_stack : public std::enable_shared_from_this<blocking_stack<T>> {
+    // tagged word: high 32 bits - ABA tag, low 32 bits - node index
+    static const uint32_t nil = 0xFFFFFFFF;
+    static const size_t elimination_size = 8;
+    static const size_t elimination_spins = 64;
+
+    class node {
+    public:
+        typename std::aligned_storage<sizeof (T), std::alignment_of<T>::value>::type storage;
+        std::atomic<uint32_t> next;
+
+        T* value() {
+            return reinterpret_cast<T*> (std::addressof(storage));
+        }
+    };
+
+    class elimination_slot {
+    public:
+        std::atomic<uint64_t> word;
+        char padding[64 - sizeof (std::atomic<uint64_t>)];
+    };
+
+    const uint32_t capacity;
+    std::unique_ptr<node[]> nodes;
+    std::unique_ptr<elimination_slot[]> elimination;
+    // hint, updated only on the elimination path
+    std::atomic<size_t> elimination_range;
+    char padding1[64];
+    std::atomic<uint64_t> head;
+    char padding2[64 - sizeof (std::atomic<uint64_t>)];
+    std::atomic<uint64_t> free_head;
+    char padding3[64 - sizeof (std::atomic<uint64_t>)];
+    std::atomic<size_t> count;
+    eventcount empty_ec;
+    std::atomic<bool> unblocked;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param max_size max number of elements in the stack
+     */
+    explicit blocking_stack(size_t max_size) :
+    capacity(static_cast<uint32_t> (max_size)),
+    nodes(new node[max_size]),
+    elimination(new elimination_slot[elimination_size]),
+    elimination_range(1),
+    head(make_word(0, nil)),
+    free_head(make_word(0, max_size > 0 ? 0 : nil)),
+    count(0),
+    unblocked(false) {
+        for (uint32_t i = 0; i < capacity; i++) {
+            nodes[i].next.store(i + 1 < capacity ? i + 1 : nil, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < elimination_size; i++) {
+            elimination[i].word.store(make_word(0, nil), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    blocking_stack(const blocking_stack&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    blocking_stack& operator=(const blocking_stack&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    blocking_stack(blocking_stack&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    blocking_stack& operator=(blocking_stack&&) = delete;
+
+    /**
+     * Destructor, destroys remaining elements
+     */
+    ~blocking_stack() {
+        uint32_t idx = word_index(head.load(std::memory_order_acquire));
+        while (nil != idx) {
+            nodes[idx].value()->~T();
+            idx = nodes[idx].next.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Emplace a value on the top of the stack
+     *
+     * @param record_args arguments for the value constructor
+     * @return false if the stack was full, true otherwise
+     */
+    template<typename ...Args>
+    bool emplace(Args&&... record_args) {
+        uint32_t idx = pop_index(free_head);
+        if (nil == idx) {
+            return false;
+        }
+        node& nd = nodes[idx];
+        try {
+            new (nd.value()) T(std::forward<Args>(record_args)...);
+        } catch (...) {
+            push_index(free_head, idx);
+            throw;
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        uint64_t rng = 0;
+        uint64_t h = head.load(std::memory_order_relaxed);
+        for (;;) {
+            nd.next.store(word_index(h), std::memory_order_relaxed);
+            if (head.compare_exchange_weak(h, make_word(word_tag(h) + 1, idx),
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                break;
+            }
+            // contention on the top, try to hand the node over directly
+            if (try_eliminate_push(idx, rng)) {
+                return true;
+            }
+            h = head.load(std::memory_order_relaxed);
+        }
+        empty_ec.notify_one();
+        return true;
+    }
+
+    /**
+     * Attempt to read the value from the top of the stack into a variable.
+     * This method returns immediately.
+     *
+     * @param record move the value from the top of the stack to given variable
+     * @return returns false if stack was empty, true otherwise
+     */
+    bool poll(T& record) {
+        uint64_t rng = 0;
+        uint64_t h = head.load(std::memory_order_acquire);
+        uint32_t idx = nil;
+        for (;;) {
+            idx = word_index(h);
+            if (nil == idx) {
+                return false;
+            }
+            uint32_t next = nodes[idx].next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(h, make_word(word_tag(h) + 1, next),
+                    std::memory_order_acquire, std::memory_order_acquire)) {
+                break;
+            }
+            idx = try_eliminate_pop(rng);
+            if (nil != idx) {
+                break;
+            }
+            h = head.load(std::memory_order_acquire);
+        }
+        take_node(idx, record);
+        return true;
+    }
+
+    /**
+     * Attempt to read the value from the top of the stack into a variable.
+     * This method will wait on empty stack infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move the value from the top of the stack to given variable
+     * @param timeout max amount of milliseconds to wait on empty stack,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if stack was empty after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (poll(record)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            auto key = empty_ec.prepare_wait();
+            if (poll(record)) {
+                empty_ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                empty_ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                empty_ec.wait(key);
+            } else if (!empty_ec.wait_until(key, deadline)) {
+                return poll(record);
+            }
+        }
+    }
+
+    /**
+     * Unblocks the stack allowing consumers to
+     * exit 'take' calls. Stack cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        unblocked.store(true, std::memory_order_release);
+        empty_ec.notify_all();
+    }
+
+    /**
+     * Checks whether this stack was unblocked
+     *
+     * @return whether this stack was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if the stack is empty, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return whether stack is empty
+     */
+    bool empty() const {
+        return nil == word_index(head.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of elements in the stack, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return number of elements in the stack
+     */
+    size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Accessor for max stack size
+     *
+     * @return max stack size
+     */
+    size_t max_size() const {
+        return capacity;
+    }
+
+private:
+    static uint64_t make_word(uint32_t tag, uint32_t idx) {
+        return (static_cast<uint64_t> (tag) << 32) | idx;
+    }
+
+    static uint32_t word_tag(uint64_t word) {
+        return static_cast<uint32_t> (word >> 32);
+    }
+
+    static uint32_t word_index(uint64_t word) {
+        return static_cast<uint32_t> (word & 0xFFFFFFFF);
+    }
+
+    uint32_t pop_index(std::atomic<uint64_t>& top) {
+        uint64_t h = top.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t idx = word_index(h);
+            if (nil == idx) {
+                return nil;
+            }
+            uint32_t next = nodes[idx].next.load(std::memory_order_relaxed);
+            if (top.compare_exchange_weak(h, make_word(word_tag(h) + 1, next),
+                    std::memory_order_acquire, std::memory_order_acquire)) {
+                return idx;
+            }
+        }
+    }
+
+    void push_index(std::atomic<uint64_t>& top, uint32_t idx) {
+        uint64_t h = top.load(std::memory_order_relaxed);
+        for (;;) {
+            nodes[idx].next.store(word_index(h), std::memory_order_relaxed);
+            if (top.compare_exchange_weak(h, make_word(word_tag(h) + 1, idx),
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    void take_node(uint32_t idx, T& record) {
+        T* ptr = nodes[idx].value();
+        record = std::move(*ptr);
+        ptr->~T();
+        count.fetch_sub(1, std::memory_order_relaxed);
+        push_index(free_head, idx);
+    }
+
+    // random slot per attempt, generator state is local to the operation
+    // and is seeded lazily, no thread-local storage and no shared counters
+    elimination_slot& pick_slot(uint64_t& rng) {
+        if (0 == rng) {
+            char local = 0;
+            rng = static_cast<uint64_t> (std::hash<std::thread::id>()(std::this_thread::get_id()));
+            rng ^= static_cast<uint64_t> (reinterpret_cast<uintptr_t> (std::addressof(local)));
+            rng += static_cast<uint64_t> (std::chrono::steady_clock::now().time_since_epoch().count()) *
+                    0x9E3779B97F4A7C15ULL;
+            rng |= 1;
+        }
+        // xorshift
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        size_t range = elimination_range.load(std::memory_order_relaxed);
+        return elimination[static_cast<size_t> (rng >> 32) % range];
+    }
+
+    void grow_range() {
+        size_t range = elimination_range.load(std::memory_order_relaxed);
+        if (range < elimination_size) {
+            elimination_range.store(range + 1, std::memory_order_relaxed);
+        }
+    }
+
+    void shrink_range() {
+        size_t range = elimination_range.load(std::memory_order_relaxed);
+        if (range > 1) {
+            elimination_range.store(range - 1, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_eliminate_push(uint32_t idx, uint64_t& rng) {
+        elimination_slot& slot = pick_slot(rng);
+        uint64_t w = slot.word.load(std::memory_order_relaxed);
+        if (nil != word_index(w)) {
+            // slot is busy with other producer
+            grow_range();
+            return false;
+        }
+        uint64_t offered = make_word(word_tag(w) + 1, idx);
+        if (!slot.word.compare_exchange_strong(w, offered,
+                std::memory_order_release, std::memory_order_relaxed)) {
+            grow_range();
+            return false;
+        }
+        for (size_t i = 0; i < elimination_spins; i++) {
+            if (offered != slot.word.load(std::memory_order_relaxed)) {
+                // taken by consumer
+                return true;
+            }
+        }
+        // withdraw the offer, failure means that consumer has taken it
+        if (slot.word.compare_exchange_strong(offered, make_word(word_tag(offered) + 1, nil),
+                std::memory_order_relaxed, std::memory_order_relaxed)) {
+            // no partner, range is too wide for current contention
+            shrink_range();
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t try_eliminate_pop(uint64_t& rng) {
+        elimination_slot& slot = pick_slot(rng);
+        uint64_t w = slot.word.load(std::memory_order_relaxed);
+        uint32_t idx = word_index(w);
+        if (nil == idx) {
+            return nil;
+        }
+        if (slot.word.compare_exchange_strong(w, make_word(word_tag(w) + 1, nil),
+                std::memory_order_acquire, std::memory_order_relaxed)) {
+            return idx;
+        }
+        // other consumer has taken it
+        grow_range();
+        return nil;
+    }
+
+};
+
+template<typename T>
+const uint32_t blocking_stack<T>::nil;
+
+template<typename T>
+const size_t blocking_stack<T>::elimination_size;
+
+template<typename T>
+const size_t blocking_stack<T>::elimination_spins;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_BLOCKING_STACK_HPP */
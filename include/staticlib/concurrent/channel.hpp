@@ -0,0 +1,665 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   channel.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_CHANNEL_HPP
+#define STATICLIB_CONCURRENT_CHANNEL_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+// based on: https://github.com/golang/go/blob/go1.9/src/runtime/chan.go
+// and https://github.com/golang/go/blob/go1.9/src/runtime/select.go
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_channel {
+
+enum class op_result {
+    would_block, done, closed
+};
+
+// lives on the stack of the blocked thread, claimed by exactly one counterpart
+class waiter {
+public:
+    static const uint32_t unclaimed = 0xFFFFFFFF;
+    static const uint32_t timed_out = 0xFFFFFFFE;
+
+    std::atomic<uint32_t> selected;
+    std::atomic<uint32_t> completed;
+    bool success = false;
+
+    waiter() :
+    selected(unclaimed),
+    completed(0) { }
+
+    bool try_claim(uint32_t case_idx) {
+        uint32_t expected = unclaimed;
+        return selected.compare_exchange_strong(expected, case_idx, std::memory_order_acq_rel,
+                std::memory_order_relaxed);
+    }
+
+    // called by the claimer under the channel lock
+    void complete(bool result) {
+        success = result;
+        completed.store(1, std::memory_order_release);
+        atomic_notify_one(completed);
+    }
+
+    void await() {
+        atomic_wait(completed, static_cast<uint32_t> (0));
+    }
+
+    bool await_until(const std::chrono::steady_clock::time_point& deadline) {
+        return atomic_wait_until(completed, static_cast<uint32_t> (0), deadline);
+    }
+};
+
+class select_case {
+public:
+    // send case, that has handed its value over, is skipped
+    bool spent = false;
+
+    virtual ~select_case() { }
+
+    virtual bool consumes_value() const = 0;
+
+    virtual std::mutex& channel_mutex() = 0;
+
+    virtual op_result try_locked() = 0;
+
+    virtual void enqueue_locked(waiter& wt, uint32_t case_idx) = 0;
+
+    virtual void dequeue_locked() = 0;
+};
+
+inline void lock_all(const std::vector<std::mutex*>& mutexes) {
+    for (std::mutex* mx : mutexes) {
+        mx->lock();
+    }
+}
+
+inline void unlock_all(const std::vector<std::mutex*>& mutexes) {
+    for (auto it = mutexes.rbegin(); it != mutexes.rend(); ++it) {
+        (*it)->unlock();
+    }
+}
+
+// all the channels are locked in address order, so the claims are never undone
+inline size_t run_select(select_case* const* cases, size_t count, size_t start, bool block,
+        std::chrono::milliseconds timeout, bool& success) {
+    const size_t none = static_cast<size_t> (-1);
+    size_t active = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!cases[i]->spent) {
+            active += 1;
+        }
+    }
+    if (0 == active) {
+        return none;
+    }
+    std::vector<std::mutex*> mutexes;
+    for (size_t i = 0; i < count; i++) {
+        mutexes.push_back(std::addressof(cases[i]->channel_mutex()));
+    }
+    std::sort(mutexes.begin(), mutexes.end());
+    mutexes.erase(std::unique(mutexes.begin(), mutexes.end()), mutexes.end());
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    lock_all(mutexes);
+    for (size_t k = 0; k < count; k++) {
+        size_t idx = (start + k) % count;
+        if (cases[idx]->spent) {
+            continue;
+        }
+        op_result res = cases[idx]->try_locked();
+        if (op_result::would_block != res) {
+            unlock_all(mutexes);
+            success = op_result::done == res;
+            return idx;
+        }
+    }
+    if (!block) {
+        unlock_all(mutexes);
+        return none;
+    }
+    waiter wt;
+    for (size_t i = 0; i < count; i++) {
+        if (!cases[i]->spent) {
+            cases[i]->enqueue_locked(wt, static_cast<uint32_t> (i));
+        }
+    }
+    unlock_all(mutexes);
+
+    bool expired = false;
+    if (std::chrono::milliseconds(0) == timeout) {
+        wt.await();
+    } else if (!wt.await_until(deadline)) {
+        uint32_t expected = waiter::unclaimed;
+        if (wt.selected.compare_exchange_strong(expected, waiter::timed_out, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            expired = true;
+        } else {
+            // claimed concurrently, transfer is in progress
+            wt.await();
+        }
+    }
+
+    lock_all(mutexes);
+    for (size_t i = 0; i < count; i++) {
+        cases[i]->dequeue_locked();
+    }
+    unlock_all(mutexes);
+    if (expired) {
+        return none;
+    }
+    success = wt.success;
+    return static_cast<size_t> (wt.selected.load(std::memory_order_acquire));
+}
+
+} // namespace
+
+/**
+ * Go-style channel with buffered and unbuffered (rendezvous) modes.
+ * Blocked senders and receivers are queued inside the channel and the value
+ * is handed over directly to the blocked counterpart. Closed channel rejects
+ * new values, buffered values can still be received. Multiple channels
+ * can be waited on at once using `selector`.
+ */
+template<typename T>
+class channel : public std::enable_shared_from_this<channel<T>> {
+    friend class selector;
+
+    class pending_op {
+    public:
+        detail_channel::waiter* wt;
+        uint32_t case_idx;
+        // destination for receive, source for send
+        T* elem;
+    };
+
+    class recv_case : public detail_channel::select_case {
+        channel& ch;
+        pending_op op;
+
+    public:
+        recv_case(channel& ch, T& dest) :
+        ch(ch) {
+            op.wt = nullptr;
+            op.case_idx = 0;
+            op.elem = std::addressof(dest);
+        }
+
+        virtual bool consumes_value() const override {
+            return false;
+        }
+
+        virtual std::mutex& channel_mutex() override {
+            return ch.mutex;
+        }
+
+        virtual detail_channel::op_result try_locked() override {
+            return ch.recv_locked(*op.elem);
+        }
+
+        virtual void enqueue_locked(detail_channel::waiter& wt, uint32_t case_idx) override {
+            op.wt = std::addressof(wt);
+            op.case_idx = case_idx;
+            ch.recvq.push_back(std::addressof(op));
+        }
+
+        virtual void dequeue_locked() override {
+            remove_op(ch.recvq, std::addressof(op));
+        }
+    };
+
+    class send_case : public detail_channel::select_case {
+        channel& ch;
+        T value;
+        pending_op op;
+
+    public:
+        send_case(channel& ch, T&& value) :
+        ch(ch),
+        value(std::move(value)) {
+            op.wt = nullptr;
+            op.case_idx = 0;
+            op.elem = std::addressof(this->value);
+        }
+
+        virtual bool consumes_value() const override {
+            return true;
+        }
+
+        virtual std::mutex& channel_mutex() override {
+            return ch.mutex;
+        }
+
+        virtual detail_channel::op_result try_locked() override {
+            return ch.send_locked(value);
+        }
+
+        virtual void enqueue_locked(detail_channel::waiter& wt, uint32_t case_idx) override {
+            op.wt = std::addressof(wt);
+            op.case_idx = case_idx;
+            ch.sendq.push_back(std::addressof(op));
+        }
+
+        virtual void dequeue_locked() override {
+            remove_op(ch.sendq, std::addressof(op));
+        }
+    };
+
+    const size_t buffer_capacity;
+    std::mutex mutex;
+    std::deque<T> buffer;
+    std::deque<pending_op*> recvq;
+    std::deque<pending_op*> sendq;
+    bool closed = false;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param capacity buffer size, zero value (supplied by default) creates
+     *        unbuffered channel, where sender waits for the receiver
+     */
+    explicit channel(size_t capacity = 0) :
+    buffer_capacity(capacity) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    channel(const channel&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    channel& operator=(const channel&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    channel(channel&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    channel& operator=(channel&&) = delete;
+
+    /**
+     * Sends the value, waits for the receiver or for the buffer space
+     * infinitely (by default), or up to specified amount of milliseconds
+     *
+     * @param value value to send
+     * @param timeout max amount of milliseconds to wait,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return false if the channel was closed or timeout expired, true otherwise
+     */
+    bool send(T value, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            detail_channel::op_result res = send_locked(value);
+            if (detail_channel::op_result::would_block != res) {
+                return detail_channel::op_result::done == res;
+            }
+        }
+        send_case sc(*this, std::move(value));
+        detail_channel::select_case* cases[] = {std::addressof(sc)};
+        bool success = false;
+        size_t idx = detail_channel::run_select(cases, 1, 0, true, timeout, success);
+        return 0 == idx && success;
+    }
+
+    /**
+     * Attempts to send the value without waiting
+     *
+     * @param value value to send
+     * @return false if the channel was closed, or it has no waiting
+     *         receivers and no buffer space, true otherwise
+     */
+    bool try_send(T value) {
+        std::lock_guard<std::mutex> guard{mutex};
+        return detail_channel::op_result::done == send_locked(value);
+    }
+
+    /**
+     * Receives the value, waits for it infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param dest move the received value to given variable
+     * @param timeout max amount of milliseconds to wait,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return false if the channel was closed and drained or timeout expired, true otherwise
+     */
+    bool recv(T& dest, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            detail_channel::op_result res = recv_locked(dest);
+            if (detail_channel::op_result::would_block != res) {
+                return detail_channel::op_result::done == res;
+            }
+        }
+        recv_case rc(*this, dest);
+        detail_channel::select_case* cases[] = {std::addressof(rc)};
+        bool success = false;
+        size_t idx = detail_channel::run_select(cases, 1, 0, true, timeout, success);
+        return 0 == idx && success;
+    }
+
+    /**
+     * Attempts to receive the value without waiting
+     *
+     * @param dest move the received value to given variable
+     * @return false if no value is available, true otherwise
+     */
+    bool try_recv(T& dest) {
+        std::lock_guard<std::mutex> guard{mutex};
+        return detail_channel::op_result::done == recv_locked(dest);
+    }
+
+    /**
+     * Closes the channel, blocked senders fail, blocked receivers
+     * fail if there are no buffered values
+     *
+     * @return false if the channel was already closed, true otherwise
+     */
+    bool close() {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (closed) {
+            return false;
+        }
+        closed = true;
+        fail_all(recvq);
+        fail_all(sendq);
+        return true;
+    }
+
+    /**
+     * Checks whether this channel was closed
+     *
+     * @return whether this channel was closed
+     */
+    bool is_closed() {
+        std::lock_guard<std::mutex> guard{mutex};
+        return closed;
+    }
+
+    /**
+     * Returns the number of buffered values
+     *
+     * @return number of buffered values
+     */
+    size_t size() {
+        std::lock_guard<std::mutex> guard{mutex};
+        return buffer.size();
+    }
+
+    /**
+     * Accessor for buffer capacity specified at creation
+     *
+     * @return buffer capacity
+     */
+    size_t capacity() const {
+        return buffer_capacity;
+    }
+
+private:
+    static void remove_op(std::deque<pending_op*>& queue, pending_op* op) {
+        auto it = std::find(queue.begin(), queue.end(), op);
+        if (queue.end() != it) {
+            queue.erase(it);
+        }
+    }
+
+    // claimed ops are never returned, ops of timed out and already completed
+    // selects are dropped here, their owners do not expect them to stay queued
+    static pending_op* claim_first(std::deque<pending_op*>& queue) {
+        while (!queue.empty()) {
+            pending_op* op = queue.front();
+            queue.pop_front();
+            if (op->wt->try_claim(op->case_idx)) {
+                return op;
+            }
+        }
+        return nullptr;
+    }
+
+    static void fail_all(std::deque<pending_op*>& queue) {
+        for (;;) {
+            pending_op* op = claim_first(queue);
+            if (nullptr == op) {
+                break;
+            }
+            op->wt->complete(false);
+        }
+    }
+
+    detail_channel::op_result send_locked(T& value) {
+        if (closed) {
+            return detail_channel::op_result::closed;
+        }
+        pending_op* receiver = claim_first(recvq);
+        if (nullptr != receiver) {
+            *receiver->elem = std::move(value);
+            receiver->wt->complete(true);
+            return detail_channel::op_result::done;
+        }
+        if (buffer.size() < buffer_capacity) {
+            buffer.push_back(std::move(value));
+            return detail_channel::op_result::done;
+        }
+        return detail_channel::op_result::would_block;
+    }
+
+    detail_channel::op_result recv_locked(T& dest) {
+        if (!buffer.empty()) {
+            dest = std::move(buffer.front());
+            buffer.pop_front();
+            pending_op* sender = claim_first(sendq);
+            if (nullptr != sender) {
+                buffer.push_back(std::move(*sender->elem));
+                sender->wt->complete(true);
+            }
+            return detail_channel::op_result::done;
+        }
+        pending_op* sender = claim_first(sendq);
+        if (nullptr != sender) {
+            dest = std::move(*sender->elem);
+            sender->wt->complete(true);
+            return detail_channel::op_result::done;
+        }
+        if (closed) {
+            return detail_channel::op_result::closed;
+        }
+        return detail_channel::op_result::would_block;
+    }
+
+};
+
+/**
+ * Waits for the first of multiple channel operations (sends and receives,
+ * possibly on channels of different types) to complete, exactly one operation
+ * is performed. Blocked selector is queued in all the channels and is woken
+ * directly by the counterpart, channels are never polled. Ready operations
+ * are checked in round-robin order between calls to avoid starvation.
+ * Receive cases can be reused by multiple calls, send case consumes its
+ * value only when it is selected and succeeds, after that it is disabled
+ * and is skipped by the next calls.
+ */
+class selector : public std::enable_shared_from_this<selector> {
+    std::vector<std::unique_ptr<detail_channel::select_case>> cases;
+    std::vector<detail_channel::select_case*> case_ptrs;
+    size_t start = 0;
+    bool last_success = false;
+
+public:
+    /**
+     * Index returned when no operation was completed
+     */
+    static const size_t timeout_index = static_cast<size_t> (-1);
+
+    /**
+     * Constructor
+     */
+    selector() { }
+
+    /**
+     * Deleted copy constructor
+     */
+    selector(const selector&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    selector& operator=(const selector&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    selector(selector&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    selector& operator=(selector&&) = delete;
+
+    /**
+     * Adds receive operation
+     *
+     * @param ch channel to receive from, must outlive this selector
+     * @param dest variable to move the received value to, must outlive this selector
+     * @return index of the operation
+     */
+    template<typename T>
+    size_t recv(channel<T>& ch, T& dest) {
+        using case_type = typename channel<T>::recv_case;
+        return add(std::unique_ptr<detail_channel::select_case>(new case_type(ch, dest)));
+    }
+
+    /**
+     * Adds send operation, it is performed at most once
+     *
+     * @param ch channel to send to, must outlive this selector
+     * @param value value to send
+     * @return index of the operation
+     */
+    template<typename T>
+    size_t send(channel<T>& ch, T value) {
+        using case_type = typename channel<T>::send_case;
+        return add(std::unique_ptr<detail_channel::select_case>(new case_type(ch, std::move(value))));
+    }
+
+    /**
+     * Performs one of the operations, waits for any of them to become
+     * ready infinitely (by default), or up to specified amount of milliseconds
+     *
+     * @param timeout max amount of milliseconds to wait,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return index of the performed operation, or `timeout_index`
+     *         (returned immediately if all the cases are disabled)
+     */
+    size_t select(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        return run(true, timeout);
+    }
+
+    /**
+     * Performs one of the operations, that are ready, without waiting
+     *
+     * @return index of the performed operation, or `timeout_index`
+     *         if no operations are ready
+     */
+    size_t try_select() {
+        return run(false, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * Checks whether the last performed operation succeeded, operations
+     * on closed channel are performed immediately and do not succeed
+     *
+     * @return false if the channel of the last performed operation was closed,
+     *         true otherwise
+     */
+    bool succeeded() const {
+        return last_success;
+    }
+
+    /**
+     * Returns the number of added operations
+     *
+     * @return number of operations
+     */
+    size_t size() const {
+        return cases.size();
+    }
+
+private:
+    // both vectors are reserved before the case is committed,
+    // so they cannot get out of sync on allocation failure
+    size_t add(std::unique_ptr<detail_channel::select_case> sc) {
+        size_t required = cases.size() + 1;
+        if (cases.capacity() < required) {
+            cases.reserve(required * 2);
+        }
+        if (case_ptrs.capacity() < required) {
+            case_ptrs.reserve(required * 2);
+        }
+        case_ptrs.push_back(sc.get());
+        cases.push_back(std::move(sc));
+        return cases.size() - 1;
+    }
+
+    size_t run(bool block, std::chrono::milliseconds timeout) {
+        last_success = false;
+        if (cases.empty()) {
+            return timeout_index;
+        }
+        size_t res = detail_channel::run_select(case_ptrs.data(), case_ptrs.size(), start, block, timeout,
+                last_success);
+        if (timeout_index != res && last_success && cases[res]->consumes_value()) {
+            cases[res]->spent = true;
+        }
+        start += 1;
+        return res;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_CHANNEL_HPP */
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   combining_blocking_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 1:30 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_COMBINING_BLOCKING_QUEUE_HPP
+#define STATICLIB_CONCURRENT_COMBINING_BLOCKING_QUEUE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/spin_mutex.hpp"
+
+// based on: "Flat Combining and the Synchronization-Parallelism Tradeoff"
+// by Danny Hendler, Itai Incze, Nir Shavit and Moran Tzafrir
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Optionally bounded growing FIFO blocking queue with the same contract as
+ * `mpmc_blocking_queue`, uses flat combining instead of locking on every operation.
+ * Threads publish their `emplace` and `poll` requests into the array of request
+ * slots, the thread that gets the combiner lock applies all the published requests
+ * in a single pass, so the queue data stays in the cache of a single core.
+ * Elements for `emplace` are constructed by the calling thread before publishing.
+ * Range operations take the combiner lock directly.
+ */
+template<typename T>
+class combining_blocking_queue : public std::enable_shared_from_this<combining_blocking_queue<T>> {
+    // request slot states
+    static const uint32_t slot_free = 0;
+    static const uint32_t slot_claimed = 1;
+    static const uint32_t slot_pending = 2;
+    static const uint32_t slot_done = 3;
+    // request kinds
+    static const uint32_t op_emplace = 0;
+    static const uint32_t op_poll = 1;
+    static const size_t spins_count = 64;
+    static const size_t combining_passes = 2;
+
+    class request_slot {
+    public:
+        std::atomic<uint32_t> state;
+        uint32_t kind = op_emplace;
+        T* value = nullptr;
+        bool result = false;
+        std::exception_ptr error;
+        char padding[64];
+
+        request_slot() :
+        state(slot_free) { }
+    };
+
+    const size_t max_queue_size;
+    const size_t slots_count;
+    std::unique_ptr<request_slot[]> slots;
+    spin_mutex combiner_mutex;
+    std::deque<T> queue;
+    std::atomic<size_t> count;
+    std::atomic<bool> unblocked;
+    eventcount ec;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of elements in the queue,
+     *        zero value (supplied by default) means unbounded queue
+     * @param slots_count number of request slots, zero value (supplied by default)
+     *        means twice the hardware concurrency
+     */
+    explicit combining_blocking_queue(size_t max_queue_size = 0, size_t slots_count = 0) :
+    max_queue_size(max_queue_size),
+    slots_count(slots_count > 0 ? slots_count : default_slots_count()),
+    slots(new request_slot[this->slots_count]),
+    count(0),
+    unblocked(false) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    combining_blocking_queue(const combining_blocking_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    combining_blocking_queue& operator=(const combining_blocking_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    combining_blocking_queue(combining_blocking_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    combining_blocking_queue& operator=(combining_blocking_queue&&) = delete;
+
+    /**
+     * Emplace a value at the end of the queue
+     *
+     * @param record_args constructor arguments for queue element
+     * @return false if the queue was full, true otherwise
+     */
+    template<typename ...Args>
+    bool emplace(Args&&... record_args) {
+        T record(std::forward<Args>(record_args)...);
+        return execute(op_emplace, record);
+    }
+
+    /**
+     * Emplace the values from specified range into
+     * this queue
+     *
+     * @param range source range
+     * @return number of elements emplaced
+     */
+    template<typename Range,
+            class = typename std::enable_if<!std::is_lvalue_reference<Range>::value>::type>
+    size_t emplace_range(Range&& range) {
+        size_t origin_size = 0;
+        size_t res = 0;
+        {
+            std::lock_guard<spin_mutex> guard{combiner_mutex};
+            origin_size = queue.size();
+            for (auto&& el : range) {
+                if (0 == max_queue_size || queue.size() < max_queue_size) {
+                    queue.emplace_back(std::move(el));
+                } else {
+                    break;
+                }
+            }
+            res = queue.size() - origin_size;
+            count.store(queue.size(), std::memory_order_relaxed);
+        }
+        if (0 == origin_size && res > 0) {
+            ec.notify_all();
+        }
+        return res;
+    }
+
+    /**
+     * Emplace the values from specified range into
+     * this queue
+     *
+     * @param range source range
+     * @return number of elements emplaced
+     */
+    template<typename Range>
+    size_t emplace_range(Range& range) {
+        size_t origin_size = 0;
+        size_t res = 0;
+        {
+            std::lock_guard<spin_mutex> guard{combiner_mutex};
+            origin_size = queue.size();
+            for (auto& el : range) {
+                if (0 == max_queue_size || queue.size() < max_queue_size) {
+                    queue.emplace_back(el);
+                } else {
+                    break;
+                }
+            }
+            res = queue.size() - origin_size;
+            count.store(queue.size(), std::memory_order_relaxed);
+        }
+        if (0 == origin_size && res > 0) {
+            ec.notify_all();
+        }
+        return res;
+    }
+
+    /**
+     * Attempt to read the value at the front to the queue into a variable.
+     * This method returns immediately.
+     *
+     * @param record move (or copy) the value at the front of the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(T& record) {
+        if (0 == count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return execute(op_poll, record);
+    }
+
+    /**
+     * Consume all the immediately-available
+     * contents of this queue into specified functor
+     *
+     * @param func functor to consume contents
+     * @return number of elements consumed
+     */
+    template<typename Func>
+    size_t poll(Func&& func) {
+        std::lock_guard<spin_mutex> guard{combiner_mutex};
+        auto origin_size = queue.size();
+        while (!queue.empty()) {
+            T record = std::move(queue.front());
+            queue.pop_front();
+            count.store(queue.size(), std::memory_order_relaxed);
+            func(std::move(record));
+        }
+        return origin_size - queue.size();
+    }
+
+    /**
+     * Attempt to read the value at the front of the queue into a variable.
+     * This method will wait on empty queue infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move (or copy) the value at the front of the queue to given variable
+     * @param timeout max amount of milliseconds to wait on empty queue,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if queue was empty after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (poll(record)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            eventcount::key_type key = ec.prepare_wait();
+            if (poll(record)) {
+                ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                ec.wait(key);
+            } else if (!ec.wait_until(key, deadline)) {
+                return poll(record);
+            }
+        }
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        unblocked.store(true, std::memory_order_release);
+        ec.notify_all();
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if the queue is empty
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        return 0 == count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if the queue is full, always false for unbounded queue
+     *
+     * @return whether queue is full
+     */
+    bool full() const {
+        if (0 == max_queue_size) {
+            return false;
+        }
+        return count.load(std::memory_order_acquire) >= max_queue_size;
+    }
+
+    /**
+     * Returns the number of entries in the queue
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+private:
+    static size_t default_slots_count() {
+        size_t hc = std::thread::hardware_concurrency();
+        return hc > 1 ? hc * 2 : 4;
+    }
+
+    bool execute(uint32_t kind, T& value) {
+        request_slot* slot = claim_slot();
+        if (nullptr == slot) {
+            // all slots are busy, apply directly under the lock
+            bool res = false;
+            bool became_non_empty = false;
+            {
+                std::lock_guard<spin_mutex> guard{combiner_mutex};
+                res = apply(kind, value, became_non_empty);
+            }
+            if (became_non_empty) {
+                ec.notify_all();
+            }
+            return res;
+        }
+        slot->kind = kind;
+        slot->value = std::addressof(value);
+        slot->state.store(slot_pending, std::memory_order_release);
+        for (size_t i = 0; slot_done != slot->state.load(std::memory_order_acquire); i++) {
+            if (0 == i % spins_count) {
+                if (combiner_mutex.try_lock()) {
+                    bool became_non_empty = combine();
+                    combiner_mutex.unlock();
+                    if (became_non_empty) {
+                        ec.notify_all();
+                    }
+                } else if (i > 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        bool res = slot->result;
+        std::exception_ptr error = std::move(slot->error);
+        slot->error = nullptr;
+        slot->state.store(slot_free, std::memory_order_release);
+        if (nullptr != error) {
+            std::rethrow_exception(error);
+        }
+        return res;
+    }
+
+    request_slot* claim_slot() {
+        size_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        size_t start = (hash ^ (hash >> 16)) % slots_count;
+        for (size_t i = 0; i < slots_count; i++) {
+            request_slot& slot = slots[(start + i) % slots_count];
+            uint32_t expected = slot_free;
+            if (slot_free == slot.state.load(std::memory_order_relaxed) &&
+                    slot.state.compare_exchange_strong(expected, slot_claimed, std::memory_order_acquire,
+                    std::memory_order_relaxed)) {
+                return std::addressof(slot);
+            }
+        }
+        return nullptr;
+    }
+
+    // must be called under the combiner lock
+    bool combine() {
+        bool became_non_empty = false;
+        for (size_t pass = 0; pass < combining_passes; pass++) {
+            bool found = false;
+            for (size_t i = 0; i < slots_count; i++) {
+                request_slot& slot = slots[i];
+                if (slot_pending != slot.state.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                found = true;
+                try {
+                    slot.result = apply(slot.kind, *slot.value, became_non_empty);
+                } catch (...) {
+                    slot.result = false;
+                    slot.error = std::current_exception();
+                }
+                slot.state.store(slot_done, std::memory_order_release);
+            }
+            if (!found) {
+                break;
+            }
+        }
+        return became_non_empty;
+    }
+
+    // must be called under the combiner lock
+    bool apply(uint32_t kind, T& value, bool& became_non_empty) {
+        if (op_emplace == kind) {
+            size_t size = queue.size();
+            if (0 != max_queue_size && size >= max_queue_size) {
+                return false;
+            }
+            queue.emplace_back(std::move(value));
+            count.store(size + 1, std::memory_order_release);
+            if (0 == size) {
+                became_non_empty = true;
+            }
+            return true;
+        }
+        if (queue.empty()) {
+            return false;
+        }
+        value = std::move(queue.front());
+        queue.pop_front();
+        count.store(queue.size(), std::memory_order_release);
+        return true;
+    }
+
+};
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::slot_free;
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::slot_claimed;
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::slot_pending;
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::slot_done;
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::op_emplace;
+
+template<typename T>
+const uint32_t combining_blocking_queue<T>::op_poll;
+
+template<typename T>
+const size_t combining_blocking_queue<T>::spins_count;
+
+template<typename T>
+const size_t combining_blocking_queue<T>::combining_passes;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_COMBINING_BLOCKING_QUEUE_HPP */
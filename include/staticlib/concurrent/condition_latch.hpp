@@ -24,21 +24,26 @@
 #ifndef STATICLIB_CONCURRENT_CONDITION_LATCH_HPP
 #define STATICLIB_CONCURRENT_CONDITION_LATCH_HPP
 
-#include <condition_variable>
+#include <chrono>
 #include <functional>
 #include <memory>
-#include <mutex>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
 
 namespace staticlib {
 namespace concurrent {
 
 /**
- * Spurious-wakeup-free lock, uses arbitrary "condition" functor to check locked/unlocked state
+ * Spurious-wakeup-free lock, uses arbitrary "condition" functor to check locked/unlocked state.
+ * Predicate type is a template parameter, so checks can be inlined. Waiters are parked on
+ * the `eventcount`, notification made after the state change is never lost and
+ * does not take any locks when there are no waiters.
  */
-class condition_latch : public std::enable_shared_from_this<condition_latch> {
-    mutable std::mutex mutex;
-    std::condition_variable cv;
-    std::function<bool()> condition;
+template<typename Predicate>
+class basic_condition_latch : public std::enable_shared_from_this<basic_condition_latch<Predicate>> {
+    Predicate condition;
+    eventcount ec;
 
 public:
     /**
@@ -46,36 +51,35 @@ public:
      * 
      * @param condition locked/unlocked state functor
      */
-    explicit condition_latch(std::function<bool()> condition) :
+    explicit basic_condition_latch(Predicate condition) :
     condition(std::move(condition)) { }
 
     /**
      * Deleted copy constructor
      */
-    condition_latch(const condition_latch&) = delete;
+    basic_condition_latch(const basic_condition_latch&) = delete;
 
     /**
      * Deleted copy assignment operator
      */
-    condition_latch& operator=(const condition_latch&) = delete;
+    basic_condition_latch& operator=(const basic_condition_latch&) = delete;
 
     /**
      * Deleted move constructor
      */
-    condition_latch(condition_latch&&) = delete;
+    basic_condition_latch(basic_condition_latch&&) = delete;
 
     /**
      * Deleted move assignment operator
      */
-    condition_latch& operator=(condition_latch&&) = delete;
+    basic_condition_latch& operator=(basic_condition_latch&&) = delete;
 
     /**
      * Wait on this latch until specified condition won't
      * become positive and latch will be notified about that
      */
     void await() {
-        std::unique_lock<std::mutex> guard{mutex};
-        cv.wait(guard, [this] {
+        ec.await([this] {
             return condition();
         });
     }
@@ -89,29 +93,58 @@ public:
      * @return false if exit on timeout expiry, true otherwise
      */
     bool await(std::chrono::milliseconds timeout) {
-        std::unique_lock<std::mutex> guard{mutex};
-        return cv.wait_for(guard, timeout, [this] {
+        return await_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * Wait on this latch until specified condition won't
+     * become positive and latch will be notified about that or
+     * specified deadline will be reached
+     * 
+     * @param deadline time point to wait until
+     * @return false if exit on deadline, true otherwise
+     */
+    bool await_until(const std::chrono::steady_clock::time_point& deadline) {
+        return ec.await_until([this] {
             return condition();
-        });
+        }, deadline);
     }
 
     /**
      * Notifies one of the threads, waiting on this lock,
-     * to awake and re-check the condition
+     * to awake and re-check the condition, must be called
+     * after the state change
      */
     void notify_one() {
-        cv.notify_one();
+        ec.notify_one();
     }
 
     /**
      * Notifies all the threads, waiting on this lock,
-     * to awake and re-check the condition
+     * to awake and re-check the condition, must be called
+     * after the state change
      */
     void notify_all() {
-        cv.notify_all();
+        ec.notify_all();
     }
 };
 
+/**
+ * Latch with the type-erased condition functor
+ */
+using condition_latch = basic_condition_latch<std::function<bool()>>;
+
+/**
+ * Creates a latch with the specified condition functor
+ *
+ * @param condition locked/unlocked state functor
+ * @return shared pointer to the latch
+ */
+template<typename Predicate>
+std::shared_ptr<basic_condition_latch<Predicate>> make_condition_latch(Predicate condition) {
+    return std::make_shared<basic_condition_latch<Predicate>>(std::move(condition));
+}
+
 } // namespace
 }
 
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   conflating_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:05 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_CONFLATING_QUEUE_HPP
+#define STATICLIB_CONCURRENT_CONFLATING_QUEUE_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Optionally bounded FIFO blocking queue of key-value pairs, that keeps at most
+ * one pending value for each key. Emplacing a value for the key, that is already
+ * queued, replaces its pending value in place, key keeps its original position
+ * in the queue. Consumers always get the freshest value for each key, so queue
+ * size is bounded by the number of distinct keys instead of the update rate.
+ * Has the same blocking contract as `mpmc_blocking_queue`, max size limits
+ * the number of distinct pending keys.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+        typename Mutex = std::mutex>
+class conflating_queue : public std::enable_shared_from_this<conflating_queue<K, V, Hash, KeyEqual, Mutex>> {
+    using cv_type = typename std::conditional<std::is_same<Mutex, std::mutex>::value,
+            std::condition_variable, eventcount_condition>::type;
+
+    mutable Mutex mutex;
+    cv_type empty_cv;
+    std::deque<K> order;
+    std::unordered_map<K, V, Hash, KeyEqual> pending;
+    const size_t max_queue_size;
+    size_t conflated = 0;
+    bool unblocked = false;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = std::pair<K, V>;
+
+    /**
+     * Type of keys
+     */
+    using key_type = K;
+
+    /**
+     * Type of values
+     */
+    using mapped_type = V;
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of distinct pending keys,
+     *        zero value (supplied by default) means unbounded queue
+     */
+    explicit conflating_queue(size_t max_queue_size = 0) :
+    max_queue_size(max_queue_size) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    conflating_queue(const conflating_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    conflating_queue& operator=(const conflating_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    conflating_queue(conflating_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    conflating_queue& operator=(conflating_queue&&) = delete;
+
+    /**
+     * Emplace a value for the specified key, replaces the pending value
+     * if the key is already queued, otherwise appends the key to the end of the queue
+     *
+     * @param key key of the value
+     * @param value_args constructor arguments for the value
+     * @return false if the key was not queued and the queue was full, true otherwise
+     */
+    template<typename ...Args>
+    bool emplace(const K& key, Args&&... value_args) {
+        std::lock_guard<Mutex> guard{mutex};
+        auto it = pending.find(key);
+        if (pending.end() != it) {
+            it->second = V(std::forward<Args>(value_args)...);
+            conflated += 1;
+            return true;
+        }
+        auto size = order.size();
+        if (0 != max_queue_size && size >= max_queue_size) {
+            return false;
+        }
+        // key is never left in one container without the other
+        order.push_back(key);
+        try {
+            pending.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                    std::forward_as_tuple(std::forward<Args>(value_args)...));
+        } catch (...) {
+            order.pop_back();
+            throw;
+        }
+        if (0 == size) {
+            empty_cv.notify_all();
+        }
+        return true;
+    }
+
+    /**
+     * Attempt to read the entry at the front to the queue into a variable.
+     * This method returns immediately.
+     *
+     * @param record move the key and the freshest value at the front of the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(value_type& record) {
+        std::lock_guard<Mutex> guard{mutex};
+        if (!order.empty()) {
+            pop_front(record);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Consume all the immediately-available
+     * contents of this queue into specified functor
+     *
+     * @param func functor to consume key-value pairs
+     * @return number of elements consumed
+     */
+    template<typename Func>
+    size_t poll(Func&& func) {
+        std::lock_guard<Mutex> guard{mutex};
+        auto origin_size = order.size();
+        while (!order.empty()) {
+            value_type record;
+            pop_front(record);
+            func(std::move(record));
+        }
+        return origin_size - order.size();
+    }
+
+    /**
+     * Attempt to read the entry at the front of the queue into a variable.
+     * This method will wait on empty queue infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move the key and the freshest value at the front of the queue to given variable
+     * @param timeout max amount of milliseconds to wait on empty queue,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if queue was empty after timeout, true otherwise
+     */
+    bool take(value_type& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        std::unique_lock<Mutex> guard{mutex};
+        if (order.empty()) {
+            auto predicate = [this] {
+                return this->unblocked || !this->order.empty();
+            };
+            if (std::chrono::milliseconds(0) == timeout) {
+                empty_cv.wait(guard, predicate);
+            } else {
+                empty_cv.wait_for(guard, timeout, predicate);
+            }
+        }
+        if (!order.empty()) {
+            pop_front(record);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        std::lock_guard<Mutex> guard{mutex};
+        this->unblocked = true;
+        if (order.empty()) {
+            empty_cv.notify_all();
+        }
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return unblocked;
+    }
+
+    /**
+     * Checks whether a value for the specified key is pending
+     *
+     * @param key key to check
+     * @return whether the key is queued
+     */
+    bool contains(const K& key) const {
+        std::lock_guard<Mutex> guard{mutex};
+        return pending.end() != pending.find(key);
+    }
+
+    /**
+     * Check if the queue is empty
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return order.empty();
+    }
+
+    /**
+     * Check if the queue is full, always false for unbounded queue,
+     * values for queued keys are accepted by the full queue
+     *
+     * @return whether queue is full
+     */
+    bool full() const {
+        std::lock_guard<Mutex> guard{mutex};
+        if (0 == max_queue_size) {
+            return false;
+        }
+        return order.size() >= max_queue_size;
+    }
+
+    /**
+     * Returns the number of distinct keys in the queue
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return order.size();
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+    /**
+     * Returns the number of values that were replaced
+     * before being consumed since the queue creation
+     *
+     * @return number of conflated values
+     */
+    size_t conflated_count() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return conflated;
+    }
+
+private:
+    void pop_front(value_type& record) {
+        auto it = pending.find(order.front());
+        record.first = std::move(order.front());
+        record.second = std::move(it->second);
+        pending.erase(it);
+        order.pop_front();
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_CONFLATING_QUEUE_HPP */
@@ -25,31 +25,41 @@
 #define STATICLIB_CONCURRENT_COUNTDOWN_LATCH_HPP
 
 #include <cstdint>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
 
 namespace staticlib {
 namespace concurrent {
 
 /**
  * Synchronization aid that allows one or more threads to wait until a set
-of operations being performed in other threads completes
+of operations being performed in other threads completes. Counter operations
+are single atomic instructions, only the transition to zero wakes the waiters.
+Latch can be destroyed by a waiter right after the `await` returns.
+Counter value must not exceed 2^32 - 1, so waiters, that watch the low
+32 bits of the counter, always observe the transition to zero.
  */
 class countdown_latch : public std::enable_shared_from_this<countdown_latch> {
-    mutable std::mutex mutex;
-    std::condition_variable cv;
-    size_t count;
+    // low 32 bits are used as a futex word
+    static const size_t max_count = 0xFFFFFFFF;
+
+    // may go below zero on extra 'count_down' calls, reported as zero
+    std::atomic<int64_t> count;
 
 public:
     /**
      * Constructor
      * 
-     * @param count initial value of the counter
+     * @param count initial value of the counter, must not exceed 2^32 - 1
+     * @throws std::invalid_argument if count is too large
      */
     explicit countdown_latch(size_t count) :
-    count(count) { }
+    count(checked_count(count)) { }
 
     /**
      * Deleted copy constructor
@@ -75,10 +85,11 @@ public:
      * Wait until the counter will go to zero
      */
     void await() {
-        std::unique_lock<std::mutex> guard{mutex};
-        cv.wait(guard, [this] {
-            return 0 == count;
-        });
+        int64_t current = count.load(std::memory_order_acquire);
+        while (current > 0) {
+            atomic_wait(count, current);
+            current = count.load(std::memory_order_acquire);
+        }
     }
 
     /**
@@ -90,30 +101,33 @@ public:
      *         if exit on timeout
      */
     bool await(std::chrono::milliseconds timeout) {
-        std::unique_lock<std::mutex> guard{mutex};
-        return cv.wait_for(guard, timeout, [this] {
-            return 0 == count;
-        });
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        int64_t current = count.load(std::memory_order_acquire);
+        while (current > 0) {
+            if (!atomic_wait_until(count, current, deadline)) {
+                return false;
+            }
+            current = count.load(std::memory_order_acquire);
+        }
+        return true;
     }
 
     /**
-     * Decrement counter by 1
+     * Decrement counter by specified value
      * 
+     * @param value decrement value, 1 by default
      * @return updated value of counter
      */
-    size_t count_down() {
-        size_t updated;
-        {
-            std::lock_guard<std::mutex> guard{mutex};
-            if (count > 0) {
-                count -= 1;            
-            }
-            updated = count;
-        }
-        if (0 == updated) {
-            cv.notify_all();
+    size_t count_down(size_t value = 1) {
+        // larger values bring the counter to zero all the same, clamped value
+        // also cannot leave the low 32 bits of the counter unchanged
+        int64_t delta = static_cast<int64_t> (value < max_count ? value : max_count);
+        int64_t prev = count.fetch_sub(delta, std::memory_order_acq_rel);
+        if (prev > 0 && prev <= delta) {
+            // latch may be already destroyed by a waiter here
+            atomic_notify_all(count);
         }
-        return updated;
+        return prev > delta ? static_cast<size_t> (prev - delta) : 0;
     }
 
     /**
@@ -122,27 +136,32 @@ public:
      * @return current counter value
      */
     size_t get_count() const {
-        std::lock_guard<std::mutex> guard{mutex};
-        return count;
+        int64_t current = count.load(std::memory_order_acquire);
+        return current > 0 ? static_cast<size_t> (current) : 0;
     }
 
     /**
      * Reset counter to new value
      * 
-     * @param count_value new value
+     * @param count_value new value, must not exceed 2^32 - 1
      * @return counter value before reset
+     * @throws std::invalid_argument if count value is too large
      */
     size_t reset(size_t count_value = 0) {
-        size_t prev = 0;
-        {
-            std::lock_guard<std::mutex> guard{mutex};
-            prev = count;
-            count = count_value;
+        int64_t prev = count.exchange(checked_count(count_value), std::memory_order_acq_rel);
+        if (0 == count_value && prev > 0) {
+            atomic_notify_all(count);
         }
-        if (0 == count_value) {
-            cv.notify_all();
+        return prev > 0 ? static_cast<size_t> (prev) : 0;
+    }
+
+private:
+    static int64_t checked_count(size_t count_value) {
+        if (count_value > max_count) {
+            throw std::invalid_argument("Invalid 'countdown_latch' count: " + std::to_string(count_value) +
+                    ", max: " + std::to_string(max_count));
         }
-        return prev;
+        return static_cast<int64_t> (count_value);
     }
 
 };
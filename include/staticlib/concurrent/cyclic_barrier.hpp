@@ -0,0 +1,207 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cyclic_barrier.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:05 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_CYCLIC_BARRIER_HPP
+#define STATICLIB_CONCURRENT_CYCLIC_BARRIER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Reusable barrier for the fixed number of participants, arrivals are
+ * combined in a tree of counters, so participants do not contend on
+ * a single counter. The last participant to arrive runs the optional
+ * completion functor and releases the others. Barrier can be destroyed
+ * by a participant right after it leaves `arrive_and_wait`.
+ */
+class cyclic_barrier : public std::enable_shared_from_this<cyclic_barrier> {
+    static const size_t nil = static_cast<size_t> (-1);
+    static const size_t spins_count = 128;
+
+    class tree_node {
+    public:
+        std::atomic<uint32_t> count;
+        uint32_t size = 0;
+        size_t parent = nil;
+        char padding[64];
+
+        tree_node() :
+        count(0) { }
+    };
+
+    const size_t parties_count;
+    const size_t fan_in;
+    std::unique_ptr<tree_node[]> nodes;
+    std::function<void()> completion;
+    char padding[64];
+    std::atomic<uint32_t> phase;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param parties number of participants
+     * @param completion functor to run by the last arrived participant
+     *        before releasing others, empty by default
+     * @param fan_in max number of participants (or child nodes)
+     *        combined in a single tree node
+     */
+    explicit cyclic_barrier(size_t parties, std::function<void()> completion = nullptr,
+            size_t fan_in = 4) :
+    parties_count(parties > 0 ? parties : 1),
+    fan_in(fan_in > 1 ? fan_in : 2),
+    completion(std::move(completion)),
+    phase(0) {
+        // sizes of tree levels, leaves first
+        std::vector<size_t> levels;
+        size_t width = parties_count;
+        do {
+            width = (width + this->fan_in - 1) / this->fan_in;
+            levels.push_back(width);
+        } while (width > 1);
+        size_t total = 0;
+        for (size_t lw : levels) {
+            total += lw;
+        }
+        nodes.reset(new tree_node[total]);
+        size_t children = parties_count;
+        size_t offset = 0;
+        for (size_t i = 0; i < levels.size(); i++) {
+            size_t next_offset = offset + levels[i];
+            for (size_t j = 0; j < levels[i]; j++) {
+                size_t first_child = j * this->fan_in;
+                size_t size = children - first_child < this->fan_in ? children - first_child : this->fan_in;
+                nodes[offset + j].size = static_cast<uint32_t> (size);
+                if (i + 1 < levels.size()) {
+                    nodes[offset + j].parent = next_offset + j / this->fan_in;
+                }
+            }
+            children = levels[i];
+            offset = next_offset;
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    cyclic_barrier(const cyclic_barrier&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    cyclic_barrier& operator=(const cyclic_barrier&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    cyclic_barrier(cyclic_barrier&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    cyclic_barrier& operator=(cyclic_barrier&&) = delete;
+
+    /**
+     * Arrives at the barrier and waits until all the participants arrive,
+     * each participant must use its own unique index; exception thrown
+     * by the completion functor is propagated to the last arrived
+     * participant after the others are released
+     *
+     * @param participant_idx index of the participant in [0, parties) range
+     * @return true for the last arrived participant, false otherwise
+     */
+    bool arrive_and_wait(size_t participant_idx) {
+        uint32_t current = phase.load(std::memory_order_acquire);
+        size_t idx = (participant_idx % parties_count) / fan_in;
+        for (;;) {
+            tree_node& nd = nodes[idx];
+            if (nd.count.fetch_add(1, std::memory_order_acq_rel) + 1 < nd.size) {
+                break;
+            }
+            // all children arrived, node is not touched again until the phase changes
+            nd.count.store(0, std::memory_order_relaxed);
+            if (nil == nd.parent) {
+                if (completion) {
+                    try {
+                        completion();
+                    } catch (...) {
+                        // counters are already reset, others are released
+                        // and the barrier stays usable for the next phase
+                        release(current);
+                        throw;
+                    }
+                }
+                release(current);
+                return true;
+            }
+            idx = nd.parent;
+        }
+        for (size_t i = 0; i < spins_count; i++) {
+            if (current != phase.load(std::memory_order_acquire)) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        atomic_wait(phase, current);
+        return false;
+    }
+
+    /**
+     * Accessor for the number of participants
+     *
+     * @return number of participants
+     */
+    size_t parties() const {
+        return parties_count;
+    }
+
+    /**
+     * Returns the number of completed barrier cycles (wraps around on overflow)
+     *
+     * @return number of completed cycles
+     */
+    uint32_t generation() const {
+        return phase.load(std::memory_order_acquire);
+    }
+
+private:
+    void release(uint32_t current) {
+        phase.store(current + 1, std::memory_order_release);
+        atomic_notify_all(phase);
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_CYCLIC_BARRIER_HPP */
@@ -0,0 +1,410 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dedup_blocking_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:30 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_DEDUP_BLOCKING_QUEUE_HPP
+#define STATICLIB_CONCURRENT_DEDUP_BLOCKING_QUEUE_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Optionally bounded FIFO blocking queue with set semantics over pending items,
+ * for jobs (cache refresh, reindexing) that are requested many times before
+ * they are picked up. Emplacing an item, that is already queued, is a no-op.
+ * Membership is checked in a lock-striped hash map, so duplicates do not contend
+ * on the queue lock. Item is released when it is taken, or, with in-progress
+ * tracking enabled, when the consumer calls `done`; item emplaced while it
+ * is in progress is queued again after `done`, so the same item is never
+ * processed concurrently. Has the same blocking contract as `mpmc_blocking_queue`.
+ */
+template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>,
+        typename Mutex = std::mutex>
+class dedup_blocking_queue : public std::enable_shared_from_this<dedup_blocking_queue<T, Hash, KeyEqual, Mutex>> {
+    using cv_type = typename std::conditional<std::is_same<Mutex, std::mutex>::value,
+            std::condition_variable, eventcount_condition>::type;
+
+    static const size_t stripes_count = 16;
+
+    enum class item_state {
+        queued, in_progress, requeue_on_done
+    };
+
+    class stripe {
+    public:
+        mutable Mutex mutex;
+        std::unordered_map<T, item_state, Hash, KeyEqual> items;
+        char padding[64];
+    };
+
+    const size_t max_queue_size;
+    const bool track_in_progress;
+    const Hash hasher;
+    stripe stripes[stripes_count];
+    mutable Mutex mutex;
+    cv_type empty_cv;
+    std::deque<T> queue;
+    bool unblocked = false;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of queued items,
+     *        zero value (supplied by default) means unbounded queue
+     * @param track_in_progress whether taken items are kept in the set
+     *        until `done` is called for them, false by default
+     */
+    explicit dedup_blocking_queue(size_t max_queue_size = 0, bool track_in_progress = false) :
+    max_queue_size(max_queue_size),
+    track_in_progress(track_in_progress),
+    hasher() { }
+
+    /**
+     * Deleted copy constructor
+     */
+    dedup_blocking_queue(const dedup_blocking_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    dedup_blocking_queue& operator=(const dedup_blocking_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    dedup_blocking_queue(dedup_blocking_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    dedup_blocking_queue& operator=(dedup_blocking_queue&&) = delete;
+
+    /**
+     * Emplace an item at the end of the queue, unless it is already queued,
+     * item that is in progress is marked to be queued again on `done`
+     *
+     * @param item item to emplace
+     * @return false if the item was already queued or the queue was full, true otherwise
+     */
+    bool emplace(const T& item) {
+        stripe& st = stripe_for(item);
+        std::lock_guard<Mutex> stripe_guard{st.mutex};
+        auto it = st.items.find(item);
+        if (st.items.end() != it) {
+            if (item_state::in_progress == it->second) {
+                it->second = item_state::requeue_on_done;
+                return true;
+            }
+            return false;
+        }
+        if (!push(item, false)) {
+            return false;
+        }
+        st.items.emplace(item, item_state::queued);
+        return true;
+    }
+
+    /**
+     * Attempt to read the item at the front to the queue into a variable.
+     * This method returns immediately.
+     *
+     * @param record move the item at the front of the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(T& record) {
+        {
+            std::lock_guard<Mutex> guard{mutex};
+            if (queue.empty()) {
+                return false;
+            }
+            record = std::move(queue.front());
+            queue.pop_front();
+        }
+        release_taken(record);
+        return true;
+    }
+
+    /**
+     * Consume all the immediately-available
+     * contents of this queue into specified functor,
+     * if the functor throws, items after the failed one
+     * are queued again at the front of the queue
+     *
+     * @param func functor to consume contents
+     * @return number of elements consumed
+     */
+    template<typename Func>
+    size_t poll(Func&& func) {
+        std::deque<T> taken;
+        {
+            std::lock_guard<Mutex> guard{mutex};
+            taken.swap(queue);
+        }
+        size_t released = 0;
+        try {
+            while (released < taken.size()) {
+                T& record = taken[released];
+                release_taken(record);
+                released += 1;
+                func(std::move(record));
+            }
+        } catch (...) {
+            requeue_front(taken, released);
+            throw;
+        }
+        return taken.size();
+    }
+
+    /**
+     * Attempt to read the item at the front of the queue into a variable.
+     * This method will wait on empty queue infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move the item at the front of the queue to given variable
+     * @param timeout max amount of milliseconds to wait on empty queue,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if queue was empty after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        {
+            std::unique_lock<Mutex> guard{mutex};
+            if (queue.empty()) {
+                auto predicate = [this] {
+                    return this->unblocked || !this->queue.empty();
+                };
+                if (std::chrono::milliseconds(0) == timeout) {
+                    empty_cv.wait(guard, predicate);
+                } else {
+                    empty_cv.wait_for(guard, timeout, predicate);
+                }
+            }
+            if (queue.empty()) {
+                return false;
+            }
+            record = std::move(queue.front());
+            queue.pop_front();
+        }
+        release_taken(record);
+        return true;
+    }
+
+    /**
+     * Marks the taken item as processed, must be called for every taken
+     * item when in-progress tracking is enabled, no-op otherwise
+     *
+     * @param item processed item
+     * @return true if the item was emplaced during processing and was queued again,
+     *         false otherwise
+     */
+    bool done(const T& item) {
+        if (!track_in_progress) {
+            return false;
+        }
+        stripe& st = stripe_for(item);
+        std::lock_guard<Mutex> stripe_guard{st.mutex};
+        auto it = st.items.find(item);
+        if (st.items.end() == it || item_state::queued == it->second) {
+            return false;
+        }
+        if (item_state::requeue_on_done == it->second) {
+            // accepted earlier, so queue bound is not checked
+            push(item, true);
+            it->second = item_state::queued;
+            return true;
+        }
+        st.items.erase(it);
+        return false;
+    }
+
+    /**
+     * Checks whether the item is queued or in progress
+     *
+     * @param item item to check
+     * @return whether the item is pending
+     */
+    bool contains(const T& item) const {
+        const stripe& st = stripe_for(item);
+        std::lock_guard<Mutex> stripe_guard{st.mutex};
+        return st.items.end() != st.items.find(item);
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        std::lock_guard<Mutex> guard{mutex};
+        this->unblocked = true;
+        if (queue.empty()) {
+            empty_cv.notify_all();
+        }
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return unblocked;
+    }
+
+    /**
+     * Check if the queue is empty
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return queue.empty();
+    }
+
+    /**
+     * Check if the queue is full, always false for unbounded queue
+     *
+     * @return whether queue is full
+     */
+    bool full() const {
+        std::lock_guard<Mutex> guard{mutex};
+        if (0 == max_queue_size) {
+            return false;
+        }
+        return queue.size() >= max_queue_size;
+    }
+
+    /**
+     * Returns the number of queued items, items
+     * in progress are not counted
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        std::lock_guard<Mutex> guard{mutex};
+        return queue.size();
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+    /**
+     * Accessor for in-progress tracking flag specified at creation
+     *
+     * @return whether in-progress tracking is enabled
+     */
+    bool tracks_in_progress() const {
+        return track_in_progress;
+    }
+
+private:
+    size_t stripe_index(const T& item) const {
+        size_t hash = hasher(item);
+        return (hash ^ (hash >> 16)) % stripes_count;
+    }
+
+    stripe& stripe_for(const T& item) {
+        return stripes[stripe_index(item)];
+    }
+
+    const stripe& stripe_for(const T& item) const {
+        return stripes[stripe_index(item)];
+    }
+
+    // items that were not released are still marked as queued in their stripes,
+    // they were accepted earlier, so queue bound is not checked
+    void requeue_front(std::deque<T>& taken, size_t from) {
+        if (from >= taken.size()) {
+            return;
+        }
+        std::lock_guard<Mutex> guard{mutex};
+        bool was_empty = queue.empty();
+        queue.insert(queue.begin(), std::make_move_iterator(taken.begin() + from),
+                std::make_move_iterator(taken.end()));
+        if (was_empty) {
+            empty_cv.notify_all();
+        }
+    }
+
+    // called under the stripe lock
+    bool push(const T& item, bool force) {
+        std::lock_guard<Mutex> guard{mutex};
+        auto size = queue.size();
+        if (!force && 0 != max_queue_size && size >= max_queue_size) {
+            return false;
+        }
+        queue.push_back(item);
+        if (0 == size) {
+            empty_cv.notify_all();
+        }
+        return true;
+    }
+
+    void release_taken(const T& item) {
+        stripe& st = stripe_for(item);
+        std::lock_guard<Mutex> stripe_guard{st.mutex};
+        auto it = st.items.find(item);
+        if (st.items.end() == it) {
+            return;
+        }
+        if (track_in_progress) {
+            it->second = item_state::in_progress;
+        } else {
+            st.items.erase(it);
+        }
+    }
+
+};
+
+template<typename T, typename Hash, typename KeyEqual, typename Mutex>
+const size_t dedup_blocking_queue<T, Hash, KeyEqual, Mutex>::stripes_count;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_DEDUP_BLOCKING_QUEUE_HPP */
@@ -0,0 +1,553 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   delay_queue.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:55 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_DELAY_QUEUE_HPP
+#define STATICLIB_CONCURRENT_DELAY_QUEUE_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// based on: "Hashed and Hierarchical Timing Wheels", Varghese, Lauck, SOSP 1987
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Optionally bounded blocking queue where elements become available to consumers
+ * only after their due `steady_clock` time. Elements are kept in the hierarchical
+ * timing wheel (4 levels of 256 slots with 1 millisecond tick), so both `emplace`
+ * and `cancel` are O(1). Consumers sleep until the next due element or until
+ * an earlier element is emplaced.
+ */
+template<typename T>
+class delay_queue : public std::enable_shared_from_this<delay_queue<T>> {
+    static const uint32_t nil = 0xFFFFFFFF;
+    static const size_t levels_count = 4;
+    static const size_t level_bits = 8;
+    static const size_t slots_count = 1 << level_bits;
+    static const uint32_t ready_list = levels_count * slots_count;
+    static const uint32_t overflow_list = ready_list + 1;
+    static const uint32_t no_list = overflow_list + 1;
+    static const uint64_t no_tick = 0xFFFFFFFFFFFFFFFFULL;
+
+    class node {
+    public:
+        typename std::aligned_storage<sizeof (T), std::alignment_of<T>::value>::type storage;
+        uint64_t due_tick = 0;
+        uint32_t prev = nil;
+        uint32_t next = nil;
+        uint32_t generation = 1;
+        uint32_t list = no_list;
+
+        T* value() {
+            return reinterpret_cast<T*> (std::addressof(storage));
+        }
+    };
+
+    class node_list {
+    public:
+        uint32_t head = nil;
+        uint32_t tail = nil;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    const size_t max_queue_size;
+    const std::chrono::steady_clock::time_point origin;
+    // deque keeps nodes in place on growth
+    std::deque<node> nodes;
+    uint32_t free_head = nil;
+    node_list lists[no_list];
+    uint64_t bitmaps[levels_count][slots_count / 64];
+    uint64_t current_tick = 0;
+    size_t count = 0;
+    size_t waiters_count = 0;
+    uint64_t wake_tick = no_tick;
+    bool unblocked = false;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Identifier of the emplaced element, can be used to cancel it
+     */
+    using id_type = uint64_t;
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of elements, zero value
+     *        (supplied by default) means unbounded queue
+     */
+    explicit delay_queue(size_t max_queue_size = 0) :
+    max_queue_size(max_queue_size),
+    origin(std::chrono::steady_clock::now()) {
+        for (size_t i = 0; i < levels_count; i++) {
+            for (size_t j = 0; j < slots_count / 64; j++) {
+                bitmaps[i][j] = 0;
+            }
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    delay_queue(const delay_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    delay_queue& operator=(const delay_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    delay_queue(delay_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    delay_queue& operator=(delay_queue&&) = delete;
+
+    /**
+     * Destructor, destroys remaining elements
+     */
+    ~delay_queue() {
+        for (node& nd : nodes) {
+            if (no_list != nd.list) {
+                nd.value()->~T();
+            }
+        }
+    }
+
+    /**
+     * Emplace a value that will become available at the specified time
+     *
+     * @param due time point when the value becomes available
+     * @param record_args constructor arguments for queue element
+     * @return identifier of the emplaced element, zero if the queue was full
+     */
+    template<typename ...Args>
+    id_type emplace(std::chrono::steady_clock::time_point due, Args&&... record_args) {
+        uint64_t tick = ceil_tick(due);
+        std::lock_guard<std::mutex> guard{mutex};
+        if (0 != max_queue_size && count >= max_queue_size) {
+            return 0;
+        }
+        uint32_t idx = alloc_node();
+        node& nd = nodes[idx];
+        try {
+            new (nd.value()) T(std::forward<Args>(record_args)...);
+        } catch (...) {
+            free_node(idx);
+            throw;
+        }
+        nd.due_tick = tick;
+        count += 1;
+        schedule(idx);
+        if (waiters_count > 0 && tick < wake_tick) {
+            wake_tick = tick;
+            cv.notify_all();
+        }
+        return (static_cast<uint64_t> (nd.generation) << 32) | (idx + 1);
+    }
+
+    /**
+     * Emplace a value that will become available after the specified delay
+     *
+     * @param delay delay from now
+     * @param record_args constructor arguments for queue element
+     * @return identifier of the emplaced element, zero if the queue was full
+     */
+    template<typename ...Args>
+    id_type emplace(std::chrono::milliseconds delay, Args&&... record_args) {
+        return emplace(std::chrono::steady_clock::now() + delay, std::forward<Args>(record_args)...);
+    }
+
+    /**
+     * Removes the element with the specified identifier from the queue
+     *
+     * @param id identifier returned from `emplace`
+     * @return true if the element was removed, false if it was
+     *         already taken or cancelled
+     */
+    bool cancel(id_type id) {
+        uint32_t idx = static_cast<uint32_t> (id & 0xFFFFFFFF) - 1;
+        uint32_t generation = static_cast<uint32_t> (id >> 32);
+        std::lock_guard<std::mutex> guard{mutex};
+        if (idx >= nodes.size()) {
+            return false;
+        }
+        node& nd = nodes[idx];
+        if (generation != nd.generation || no_list == nd.list) {
+            return false;
+        }
+        unlink(idx);
+        nd.value()->~T();
+        free_node(idx);
+        count -= 1;
+        return true;
+    }
+
+    /**
+     * Attempt to read the due value into a variable.
+     * This method returns immediately.
+     *
+     * @param record move (or copy) the due value to given variable
+     * @return returns false if there were no due values, true otherwise
+     */
+    bool poll(T& record) {
+        std::lock_guard<std::mutex> guard{mutex};
+        advance(floor_tick(std::chrono::steady_clock::now()));
+        return pop_ready(record);
+    }
+
+    /**
+     * Attempt to read the due value into a variable.
+     * This method will wait infinitely (by default), or up to
+     * specified amount of milliseconds, for a value to become due
+     *
+     * @param record move (or copy) the due value to given variable
+     * @param timeout max amount of milliseconds to wait,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if there were no due values after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> guard{mutex};
+        for (;;) {
+            auto now = std::chrono::steady_clock::now();
+            advance(floor_tick(now));
+            if (pop_ready(record)) {
+                return true;
+            }
+            if (unblocked) {
+                return false;
+            }
+            bool infinite = std::chrono::milliseconds(0) == timeout;
+            if (!infinite && now >= deadline) {
+                return false;
+            }
+            uint64_t tick = next_event_tick();
+            wake_tick = tick;
+            waiters_count += 1;
+            if (no_tick == tick) {
+                if (infinite) {
+                    cv.wait(guard);
+                } else {
+                    cv.wait_until(guard, deadline);
+                }
+            } else {
+                auto wake = origin + std::chrono::milliseconds(tick);
+                cv.wait_until(guard, infinite || wake < deadline ? wake : deadline);
+            }
+            waiters_count -= 1;
+            if (0 == waiters_count) {
+                wake_tick = no_tick;
+            }
+        }
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        std::lock_guard<std::mutex> guard{mutex};
+        this->unblocked = true;
+        cv.notify_all();
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return unblocked;
+    }
+
+    /**
+     * Check if the queue is empty (including the elements that are not due yet)
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return 0 == count;
+    }
+
+    /**
+     * Returns the number of entries in the queue (including
+     * the elements that are not due yet)
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> guard{mutex};
+        return count;
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+private:
+    uint64_t ceil_tick(std::chrono::steady_clock::time_point tp) const {
+        if (tp <= origin) {
+            return 0;
+        }
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - origin).count();
+        return static_cast<uint64_t> ((nanos + 999999) / 1000000);
+    }
+
+    uint64_t floor_tick(std::chrono::steady_clock::time_point tp) const {
+        if (tp <= origin) {
+            return 0;
+        }
+        return static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::milliseconds>(tp - origin).count());
+    }
+
+    uint32_t alloc_node() {
+        if (nil != free_head) {
+            uint32_t idx = free_head;
+            free_head = nodes[idx].next;
+            return idx;
+        }
+        nodes.emplace_back();
+        return static_cast<uint32_t> (nodes.size() - 1);
+    }
+
+    void free_node(uint32_t idx) {
+        node& nd = nodes[idx];
+        nd.generation += 1;
+        if (0 == nd.generation) {
+            nd.generation = 1;
+        }
+        nd.list = no_list;
+        nd.prev = nil;
+        nd.next = free_head;
+        free_head = idx;
+    }
+
+    void link(uint32_t list_id, uint32_t idx) {
+        node& nd = nodes[idx];
+        node_list& li = lists[list_id];
+        nd.list = list_id;
+        nd.next = nil;
+        nd.prev = li.tail;
+        if (nil != li.tail) {
+            nodes[li.tail].next = idx;
+        } else {
+            li.head = idx;
+        }
+        li.tail = idx;
+        if (list_id < ready_list) {
+            bitmaps[list_id / slots_count][(list_id % slots_count) / 64] |= (1ULL << (list_id % 64));
+        }
+    }
+
+    void unlink(uint32_t idx) {
+        node& nd = nodes[idx];
+        node_list& li = lists[nd.list];
+        if (nil != nd.prev) {
+            nodes[nd.prev].next = nd.next;
+        } else {
+            li.head = nd.next;
+        }
+        if (nil != nd.next) {
+            nodes[nd.next].prev = nd.prev;
+        } else {
+            li.tail = nd.prev;
+        }
+        if (nd.list < ready_list && nil == li.head) {
+            bitmaps[nd.list / slots_count][(nd.list % slots_count) / 64] &= ~(1ULL << (nd.list % 64));
+        }
+        nd.list = no_list;
+        nd.prev = nil;
+        nd.next = nil;
+    }
+
+    void schedule(uint32_t idx) {
+        uint64_t due = nodes[idx].due_tick;
+        if (due <= current_tick) {
+            link(ready_list, idx);
+            return;
+        }
+        // the lowest level where due and current ticks share all the higher bits
+        for (size_t level = 0; level < levels_count; level++) {
+            size_t shift = level_bits * (level + 1);
+            if (0 == ((due ^ current_tick) >> shift)) {
+                size_t slot = static_cast<size_t> (due >> (level_bits * level)) % slots_count;
+                link(static_cast<uint32_t> (level * slots_count + slot), idx);
+                return;
+            }
+        }
+        link(overflow_list, idx);
+    }
+
+    void cascade(uint32_t list_id) {
+        // detach the whole list first, overflow elements may be re-linked into it
+        uint32_t idx = lists[list_id].head;
+        lists[list_id].head = nil;
+        lists[list_id].tail = nil;
+        if (list_id < ready_list) {
+            bitmaps[list_id / slots_count][(list_id % slots_count) / 64] &= ~(1ULL << (list_id % 64));
+        }
+        while (nil != idx) {
+            uint32_t next = nodes[idx].next;
+            schedule(idx);
+            idx = next;
+        }
+    }
+
+    void process_tick(uint64_t tick) {
+        current_tick = tick;
+        if (0 == (tick & 0xFFFFFFFFULL)) {
+            cascade(overflow_list);
+        }
+        for (size_t level = levels_count - 1; level > 0; level--) {
+            uint64_t mask = (1ULL << (level_bits * level)) - 1;
+            if (0 == (tick & mask)) {
+                size_t slot = static_cast<size_t> (tick >> (level_bits * level)) % slots_count;
+                cascade(static_cast<uint32_t> (level * slots_count + slot));
+            }
+        }
+        cascade(static_cast<uint32_t> (tick % slots_count));
+    }
+
+    void advance(uint64_t target) {
+        while (current_tick < target) {
+            uint64_t tick = next_event_tick();
+            if (tick > target) {
+                // nothing to expire or cascade up to the target
+                current_tick = target;
+                return;
+            }
+            process_tick(tick);
+        }
+    }
+
+    // tick when the next element expires (level 0) or is cascaded (higher levels)
+    uint64_t next_event_tick() const {
+        for (size_t level = 0; level < levels_count; level++) {
+            size_t shift = level_bits * level;
+            size_t current_slot = static_cast<size_t> (current_tick >> shift) % slots_count;
+            size_t slot = find_next_slot(level, current_slot + 1);
+            if (slot < slots_count) {
+                uint64_t base = (current_tick >> (shift + level_bits)) << (shift + level_bits);
+                return base + (static_cast<uint64_t> (slot) << shift);
+            }
+        }
+        if (nil != lists[overflow_list].head) {
+            return ((current_tick >> 32) + 1) << 32;
+        }
+        return no_tick;
+    }
+
+    size_t find_next_slot(size_t level, size_t from) const {
+        for (size_t word = from / 64; word < slots_count / 64; word++) {
+            uint64_t bits = bitmaps[level][word];
+            if (word == from / 64) {
+                bits &= ~((1ULL << (from % 64)) - 1);
+            }
+            if (0 != bits) {
+                return word * 64 + lowest_bit(bits);
+            }
+        }
+        return slots_count;
+    }
+
+    static size_t lowest_bit(uint64_t bits) {
+#ifdef __GNUC__
+        return static_cast<size_t> (__builtin_ctzll(bits));
+#else // !__GNUC__
+        size_t res = 0;
+        while (0 == (bits & 1)) {
+            bits >>= 1;
+            res += 1;
+        }
+        return res;
+#endif // __GNUC__
+    }
+
+    bool pop_ready(T& record) {
+        uint32_t idx = lists[ready_list].head;
+        if (nil == idx) {
+            return false;
+        }
+        unlink(idx);
+        T* ptr = nodes[idx].value();
+        record = std::move(*ptr);
+        ptr->~T();
+        free_node(idx);
+        count -= 1;
+        return true;
+    }
+
+};
+
+template<typename T>
+const uint32_t delay_queue<T>::nil;
+
+template<typename T>
+const size_t delay_queue<T>::levels_count;
+
+template<typename T>
+const size_t delay_queue<T>::level_bits;
+
+template<typename T>
+const size_t delay_queue<T>::slots_count;
+
+template<typename T>
+const uint32_t delay_queue<T>::ready_list;
+
+template<typename T>
+const uint32_t delay_queue<T>::overflow_list;
+
+template<typename T>
+const uint32_t delay_queue<T>::no_list;
+
+template<typename T>
+const uint64_t delay_queue<T>::no_tick;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_DELAY_QUEUE_HPP */
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   distributed_shared_mutex.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:10 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_DISTRIBUTED_SHARED_MUTEX_HPP
+#define STATICLIB_CONCURRENT_DISTRIBUTED_SHARED_MUTEX_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Reader-writer lock for read-mostly data ("big-reader" lock). Readers
+ * are counted in multiple shards selected by thread id, each shard
+ * on its own cache line, so readers on different cores do not contend.
+ * Writer marks all the shards and waits for their readers to leave,
+ * writers are preferred over the new readers. Intended for rare writes.
+ * Satisfies `SharedMutex` requirements, shared lock must be released
+ * by the same thread that acquired it.
+ */
+class distributed_shared_mutex {
+    // shard word: readers count - bits 0-29, readers blocked - bit 30, writer - bit 31
+    static const uint32_t count_mask = (1u << 30) - 1;
+    static const uint32_t waiting_bit = 1u << 30;
+    static const uint32_t writer_bit = 1u << 31;
+    static const size_t spins_count = 128;
+
+    class shard {
+    public:
+        std::atomic<uint32_t> word;
+        char padding[64 - sizeof (std::atomic<uint32_t>)];
+
+        shard() :
+        word(0) { }
+    };
+
+    const size_t shards_mask;
+    std::unique_ptr<shard[]> shards;
+    std::mutex writer_mutex;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param shards_count number of reader shards, rounded up to the power of 2,
+     *        zero value (supplied by default) means twice the hardware concurrency
+     */
+    explicit distributed_shared_mutex(size_t shards_count = 0) :
+    shards_mask(round_up(shards_count > 0 ? shards_count : std::thread::hardware_concurrency() * 2) - 1),
+    shards(new shard[shards_mask + 1]) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    distributed_shared_mutex(const distributed_shared_mutex&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    distributed_shared_mutex& operator=(const distributed_shared_mutex&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    distributed_shared_mutex(distributed_shared_mutex&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    distributed_shared_mutex& operator=(distributed_shared_mutex&&) = delete;
+
+    /**
+     * Locks the mutex for exclusive access, blocks until
+     * all the readers will leave
+     */
+    void lock() {
+        writer_mutex.lock();
+        for (size_t i = 0; i <= shards_mask; i++) {
+            shard& sh = shards[i];
+            uint32_t word = sh.word.fetch_or(writer_bit, std::memory_order_acq_rel) | writer_bit;
+            for (size_t j = 0; 0 != (word & count_mask); j++) {
+                if (j < spins_count) {
+                    std::this_thread::yield();
+                } else {
+                    atomic_wait(sh.word, word);
+                }
+                word = sh.word.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    /**
+     * Tries to lock the mutex for exclusive access, returns immediately
+     *
+     * @return true if the mutex was locked, false otherwise
+     */
+    bool try_lock() {
+        if (!writer_mutex.try_lock()) {
+            return false;
+        }
+        for (size_t i = 0; i <= shards_mask; i++) {
+            uint32_t word = shards[i].word.fetch_or(writer_bit, std::memory_order_acq_rel);
+            if (0 != (word & count_mask)) {
+                release_shards(i + 1);
+                writer_mutex.unlock();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Unlocks the mutex locked for exclusive access
+     */
+    void unlock() {
+        release_shards(shards_mask + 1);
+        writer_mutex.unlock();
+    }
+
+    /**
+     * Locks the mutex for shared access, touches only the
+     * shard of calling thread when there is no writer
+     */
+    void lock_shared() {
+        shard& sh = current_shard();
+        for (;;) {
+            uint32_t word = sh.word.fetch_add(1, std::memory_order_acquire);
+            if (0 == (word & writer_bit)) {
+                return;
+            }
+            leave(sh);
+            await_writer(sh);
+        }
+    }
+
+    /**
+     * Tries to lock the mutex for shared access, returns immediately
+     *
+     * @return true if the mutex was locked, false otherwise
+     */
+    bool try_lock_shared() {
+        shard& sh = current_shard();
+        uint32_t word = sh.word.fetch_add(1, std::memory_order_acquire);
+        if (0 == (word & writer_bit)) {
+            return true;
+        }
+        leave(sh);
+        return false;
+    }
+
+    /**
+     * Unlocks the mutex locked for shared access
+     */
+    void unlock_shared() {
+        leave(current_shard());
+    }
+
+private:
+    static size_t round_up(size_t size) {
+        size_t res = 1;
+        while (res < size) {
+            res <<= 1;
+        }
+        return res;
+    }
+
+    shard& current_shard() {
+        size_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        return shards[(hash ^ (hash >> 16)) & shards_mask];
+    }
+
+    static void leave(shard& sh) {
+        uint32_t word = sh.word.fetch_sub(1, std::memory_order_release);
+        if (0 != (word & writer_bit) && 1 == (word & count_mask)) {
+            // the last reader in shard wakes the writer, only the address is used
+            atomic_notify_all(sh.word);
+        }
+    }
+
+    static void await_writer(shard& sh) {
+        uint32_t word = sh.word.load(std::memory_order_acquire);
+        while (0 != (word & writer_bit)) {
+            if (0 == (word & waiting_bit)) {
+                if (!sh.word.compare_exchange_weak(word, word | waiting_bit, std::memory_order_acq_rel,
+                        std::memory_order_acquire)) {
+                    continue;
+                }
+                word |= waiting_bit;
+            }
+            atomic_wait(sh.word, word);
+            word = sh.word.load(std::memory_order_acquire);
+        }
+    }
+
+    void release_shards(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            shard& sh = shards[i];
+            uint32_t word = sh.word.fetch_and(~(writer_bit | waiting_bit), std::memory_order_release);
+            if (0 != (word & waiting_bit)) {
+                atomic_notify_all(sh.word);
+            }
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_DISTRIBUTED_SHARED_MUTEX_HPP */
@@ -0,0 +1,369 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   eventcount.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:12 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_EVENTCOUNT_HPP
+#define STATICLIB_CONCURRENT_EVENTCOUNT_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else // !__linux__
+#include <condition_variable>
+#include <mutex>
+#endif // __linux__
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Lightweight parking primitive for lock-free data structures.
+ * Waiter announces itself with `prepare_wait`, re-checks its condition
+ * and only then blocks in `wait`, notifiers do not touch any locks
+ * when there are no waiters. Uses futex on Linux and a mutex
+ * with a condition variable on other platforms.
+ */
+class eventcount : public std::enable_shared_from_this<eventcount> {
+    std::atomic<uint32_t> epoch;
+    std::atomic<uint32_t> waiters;
+#ifndef __linux__
+    std::mutex mutex;
+    std::condition_variable cv;
+#endif // !__linux__
+
+public:
+    /**
+     * Type of the key returned from `prepare_wait`
+     */
+    using key_type = uint32_t;
+
+    /**
+     * Constructor
+     */
+    eventcount() :
+    epoch(0),
+    waiters(0) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    eventcount(const eventcount&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    eventcount& operator=(const eventcount&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    eventcount(eventcount&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    eventcount& operator=(eventcount&&) = delete;
+
+    /**
+     * Registers calling thread as a waiter, condition must be re-checked
+     * after this call and before `wait`, `cancel_wait` must be called
+     * if the condition became positive
+     *
+     * @return key to pass into `wait`
+     */
+    key_type prepare_wait() {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * Deregisters calling thread after `prepare_wait`
+     */
+    void cancel_wait() {
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    /**
+     * Blocks until notification is received after `prepare_wait` call,
+     * may return spuriously, so the condition must be re-checked
+     *
+     * @param key value returned from `prepare_wait`
+     */
+    void wait(key_type key) {
+#ifdef __linux__
+        while (key == epoch.load(std::memory_order_acquire)) {
+            futex_wait(key, nullptr);
+        }
+#else // !__linux__
+        {
+            std::unique_lock<std::mutex> guard{mutex};
+            while (key == epoch.load(std::memory_order_relaxed)) {
+                cv.wait(guard);
+            }
+        }
+#endif // __linux__
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    /**
+     * Blocks until notification is received after `prepare_wait` call
+     * or until deadline is reached, may return spuriously
+     *
+     * @param key value returned from `prepare_wait`
+     * @param deadline time point to wait until
+     * @return false if exit on deadline, true otherwise
+     */
+    bool wait_until(key_type key, const std::chrono::steady_clock::time_point& deadline) {
+        bool notified = true;
+#ifdef __linux__
+        while (key == epoch.load(std::memory_order_acquire)) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                notified = false;
+                break;
+            }
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            struct timespec ts;
+            ts.tv_sec = static_cast<time_t> (nanos / 1000000000);
+            ts.tv_nsec = static_cast<long> (nanos % 1000000000);
+            futex_wait(key, std::addressof(ts));
+        }
+#else // !__linux__
+        {
+            std::unique_lock<std::mutex> guard{mutex};
+            while (key == epoch.load(std::memory_order_relaxed)) {
+                if (std::cv_status::timeout == cv.wait_until(guard, deadline)) {
+                    notified = key != epoch.load(std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+#endif // __linux__
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+        return notified;
+    }
+
+    /**
+     * Wakes one of the waiting threads, cheap if there are no waiters,
+     * must be called after the condition was changed
+     */
+    void notify_one() {
+        notify(false);
+    }
+
+    /**
+     * Wakes all the waiting threads, cheap if there are no waiters,
+     * must be called after the condition was changed
+     */
+    void notify_all() {
+        notify(true);
+    }
+
+    /**
+     * Blocks until specified predicate will become positive,
+     * predicate is re-checked after each notification
+     *
+     * @param predicate condition functor
+     */
+    template<typename Predicate>
+    void await(Predicate predicate) {
+        while (!predicate()) {
+            key_type key = prepare_wait();
+            if (predicate()) {
+                cancel_wait();
+                return;
+            }
+            wait(key);
+        }
+    }
+
+    /**
+     * Blocks until specified predicate will become positive
+     * or until deadline is reached
+     *
+     * @param predicate condition functor
+     * @param deadline time point to wait until
+     * @return predicate value on exit
+     */
+    template<typename Predicate>
+    bool await_until(Predicate predicate, const std::chrono::steady_clock::time_point& deadline) {
+        while (!predicate()) {
+            key_type key = prepare_wait();
+            if (predicate()) {
+                cancel_wait();
+                return true;
+            }
+            if (!wait_until(key, deadline)) {
+                return predicate();
+            }
+        }
+        return true;
+    }
+
+private:
+    void notify(bool all) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (0 == waiters.load(std::memory_order_relaxed)) {
+            return;
+        }
+#ifdef __linux__
+        epoch.fetch_add(1, std::memory_order_release);
+        futex_wake(all ? INT_MAX : 1);
+#else // !__linux__
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            epoch.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (all) {
+            cv.notify_all();
+        } else {
+            cv.notify_one();
+        }
+#endif // __linux__
+    }
+
+#ifdef __linux__
+    void futex_wait(key_type key, struct timespec* timeout) {
+        static_assert(sizeof (std::atomic<uint32_t>) == sizeof (uint32_t), "Invalid futex word size");
+        // EINTR, EAGAIN and ETIMEDOUT are handled by callers re-checking the epoch
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*> (std::addressof(epoch)),
+                FUTEX_WAIT_PRIVATE, key, timeout, nullptr, 0);
+    }
+
+    void futex_wake(int count) {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*> (std::addressof(epoch)),
+                FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+#endif // __linux__
+
+};
+
+/**
+ * Condition variable for the `Lockable` types other than `std::mutex`
+ * (`spin_mutex`, `ticket_mutex`, `mcs_mutex`) built on `eventcount`,
+ * unlike `std::condition_variable_any` it does not lock an internal mutex
+ * on every wait and notify, notification without waiters is a fence
+ * and a single atomic load. Notifications must be sent under the same lock
+ * that is used for waiting.
+ */
+class eventcount_condition : public std::enable_shared_from_this<eventcount_condition> {
+    eventcount ec;
+
+public:
+    /**
+     * Constructor
+     */
+    eventcount_condition() { }
+
+    /**
+     * Deleted copy constructor
+     */
+    eventcount_condition(const eventcount_condition&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    eventcount_condition& operator=(const eventcount_condition&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    eventcount_condition(eventcount_condition&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    eventcount_condition& operator=(eventcount_condition&&) = delete;
+
+    /**
+     * Blocks until specified predicate will become positive,
+     * lock is released while blocked
+     *
+     * @param guard locked lock
+     * @param predicate condition functor, called under the lock
+     */
+    template<typename Lock, typename Predicate>
+    void wait(Lock& guard, Predicate predicate) {
+        while (!predicate()) {
+            // registered under the lock, so the notification
+            // sent after the condition change is not lost
+            eventcount::key_type key = ec.prepare_wait();
+            guard.unlock();
+            ec.wait(key);
+            guard.lock();
+        }
+    }
+
+    /**
+     * Blocks until specified predicate will become positive
+     * or until specified timeout will be expired,
+     * lock is released while blocked
+     *
+     * @param guard locked lock
+     * @param timeout max time period to wait
+     * @param predicate condition functor, called under the lock
+     * @return predicate value on exit
+     */
+    template<typename Lock, typename Rep, typename Period, typename Predicate>
+    bool wait_for(Lock& guard, const std::chrono::duration<Rep, Period>& timeout, Predicate predicate) {
+        auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+        while (!predicate()) {
+            eventcount::key_type key = ec.prepare_wait();
+            guard.unlock();
+            bool notified = ec.wait_until(key, deadline);
+            guard.lock();
+            if (!notified) {
+                return predicate();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Wakes one of the waiting threads
+     */
+    void notify_one() {
+        ec.notify_one();
+    }
+
+    /**
+     * Wakes all the waiting threads
+     */
+    void notify_all() {
+        ec.notify_all();
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_EVENTCOUNT_HPP */
@@ -0,0 +1,451 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fork_join_pool.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:35 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_FORK_JOIN_POOL_HPP
+#define STATICLIB_CONCURRENT_FORK_JOIN_POOL_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/mpmc_blocking_queue.hpp"
+#include "staticlib/concurrent/work_stealing_deque.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_fork_join_pool {
+
+class task {
+public:
+    virtual ~task() { }
+
+    virtual void run() = 0;
+
+    // called instead of 'run' for the tasks discarded on shutdown
+    virtual void discard() { }
+};
+
+template<typename Func>
+class func_task : public task {
+    Func func;
+
+public:
+    explicit func_task(Func&& func) :
+    func(std::move(func)) { }
+
+    virtual void run() override {
+        try {
+            func();
+        } catch (...) {
+            // exceptions from detached tasks are ignored
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * Fork/join thread pool with per-worker work-stealing deques, tasks forked
+ * from the worker threads are executed in LIFO order by the same worker
+ * and can be stolen in FIFO order by idle workers; idle workers are parked
+ * on an eventcount
+ */
+class fork_join_pool : public std::enable_shared_from_this<fork_join_pool> {
+    using task_type = detail_fork_join_pool::task;
+
+    class worker {
+    public:
+        work_stealing_deque<task_type*> deque;
+        std::thread thread;
+        // set before the workers are started, 'thread' is modified on join
+        std::thread::id thread_id;
+        uint64_t rng_state;
+
+        explicit worker(uint64_t seed) :
+        rng_state(seed) { }
+    };
+
+    std::vector<std::unique_ptr<worker>> workers;
+    mpmc_blocking_queue<task_type*> injection_queue;
+    eventcount idle_ec;
+    std::atomic<bool> started;
+    std::atomic<bool> stopping;
+
+public:
+    /**
+     * Group of forked tasks that can be joined
+     */
+    class task_group {
+        template<typename Func>
+        class group_task : public task_type {
+            task_group& group;
+            Func func;
+
+        public:
+            group_task(task_group& group, Func&& func) :
+            group(group),
+            func(std::move(func)) { }
+
+            virtual void run() override {
+                try {
+                    func();
+                } catch (...) {
+                    group.set_exception(std::current_exception());
+                }
+                group.complete_one();
+            }
+
+            virtual void discard() override {
+                group.set_exception(std::make_exception_ptr(
+                        std::runtime_error("Task discarded on 'fork_join_pool' shutdown")));
+                group.complete_one();
+            }
+        };
+
+        fork_join_pool& pool;
+        std::atomic<size_t> pending;
+        std::atomic<size_t> notifying;
+        eventcount join_ec;
+        std::mutex exception_mutex;
+        std::exception_ptr exception;
+
+    public:
+        /**
+         * Constructor
+         *
+         * @param pool pool to run the tasks in
+         */
+        explicit task_group(fork_join_pool& pool) :
+        pool(pool),
+        pending(0),
+        notifying(0) { }
+
+        /**
+         * Deleted copy constructor
+         */
+        task_group(const task_group&) = delete;
+
+        /**
+         * Deleted copy assignment operator
+         */
+        task_group& operator=(const task_group&) = delete;
+
+        /**
+         * Destructor, waits for the forked tasks to complete
+         */
+        ~task_group() {
+            await_completion();
+        }
+
+        /**
+         * Forks specified functor as a task, when called from the pool worker
+         * thread, the task is pushed into this worker's deque
+         *
+         * @param func task functor
+         */
+        template<typename Func>
+        void fork(Func&& func) {
+            using func_type = typename std::decay<Func>::type;
+            // task is constructed before it is counted, so the throwing
+            // allocation or functor copy does not leave the group pending
+            std::unique_ptr<group_task<func_type>> task{
+                    new group_task<func_type>(*this, func_type(std::forward<Func>(func)))};
+            pending.fetch_add(1, std::memory_order_relaxed);
+            try {
+                pool.schedule(task.get());
+            } catch (...) {
+                complete_one();
+                throw;
+            }
+            task.release();
+        }
+
+        /**
+         * Waits for all the forked tasks to complete, pool worker threads
+         * execute pending tasks while waiting; rethrows the first exception
+         * thrown by the tasks of this group, tasks discarded on pool shutdown
+         * are reported with `std::runtime_error`
+         */
+        void join() {
+            worker* self = pool.current_worker();
+            if (nullptr != self) {
+                help_until_completion(*self);
+            }
+            await_completion();
+            std::exception_ptr ex;
+            {
+                std::lock_guard<std::mutex> guard{exception_mutex};
+                ex = exception;
+                exception = nullptr;
+            }
+            if (nullptr != ex) {
+                std::rethrow_exception(ex);
+            }
+        }
+
+    private:
+        void set_exception(std::exception_ptr ex) {
+            std::lock_guard<std::mutex> guard{exception_mutex};
+            if (nullptr == exception) {
+                exception = std::move(ex);
+            }
+        }
+
+        void complete_one() {
+            // group may be destroyed by the joiner right after the last decrement,
+            // 'notifying' keeps it alive until the notification is sent
+            notifying.fetch_add(1, std::memory_order_acq_rel);
+            if (1 == pending.fetch_sub(1, std::memory_order_acq_rel)) {
+                join_ec.notify_all();
+                // joining workers are parked on the pool eventcount
+                pool.idle_ec.notify_all();
+            }
+            notifying.fetch_sub(1, std::memory_order_release);
+        }
+
+        // joining worker runs any available tasks, including subtasks of this
+        // group forked later by other workers, and parks only when there is
+        // nothing to run; shutdown is ignored here, so the tasks this group
+        // waits for are not left in the deques of the stopping pool
+        void help_until_completion(worker& self) {
+            for (;;) {
+                if (0 == pending.load(std::memory_order_acquire)) {
+                    return;
+                }
+                if (pool.run_one(self)) {
+                    continue;
+                }
+                auto key = pool.idle_ec.prepare_wait();
+                if (0 == pending.load(std::memory_order_seq_cst) || pool.has_work()) {
+                    pool.idle_ec.cancel_wait();
+                    continue;
+                }
+                pool.idle_ec.wait(key);
+            }
+        }
+
+        void await_completion() {
+            join_ec.await([this] {
+                return 0 == this->pending.load(std::memory_order_acquire);
+            });
+            while (notifying.load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    /**
+     * Constructor, starts worker threads
+     *
+     * @param threads_count number of worker threads, zero value
+     *        (supplied by default) means hardware concurrency
+     */
+    explicit fork_join_pool(size_t threads_count = 0) :
+    started(false),
+    stopping(false) {
+        size_t count = threads_count > 0 ? threads_count : std::thread::hardware_concurrency();
+        if (0 == count) {
+            count = 1;
+        }
+        for (size_t i = 0; i < count; i++) {
+            workers.emplace_back(new worker(0x9E3779B97F4A7C15ULL * (i + 1)));
+        }
+        for (size_t i = 0; i < count; i++) {
+            worker* wo = workers[i].get();
+            wo->thread = std::thread([this, wo] {
+                this->worker_loop(*wo);
+            });
+            wo->thread_id = wo->thread.get_id();
+        }
+        started.store(true, std::memory_order_release);
+        idle_ec.notify_all();
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    fork_join_pool(const fork_join_pool&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    fork_join_pool& operator=(const fork_join_pool&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    fork_join_pool(fork_join_pool&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    fork_join_pool& operator=(fork_join_pool&&) = delete;
+
+    /**
+     * Destructor, stops and joins worker threads, tasks that
+     * were not started yet are discarded, joins of their groups
+     * throw `std::runtime_error`
+     */
+    ~fork_join_pool() {
+        stopping.store(true, std::memory_order_seq_cst);
+        idle_ec.notify_all();
+        for (auto& wo : workers) {
+            wo->thread.join();
+        }
+        task_type* task = nullptr;
+        for (auto& wo : workers) {
+            while (wo->deque.pop(task)) {
+                task->discard();
+                delete task;
+            }
+        }
+        while (injection_queue.poll(task)) {
+            task->discard();
+            delete task;
+        }
+    }
+
+    /**
+     * Submits specified functor for the execution, exceptions thrown
+     * from the submitted functor are ignored
+     *
+     * @param func task functor
+     */
+    template<typename Func>
+    void submit(Func&& func) {
+        using func_type = typename std::decay<Func>::type;
+        schedule(new detail_fork_join_pool::func_task<func_type>(func_type(std::forward<Func>(func))));
+    }
+
+    /**
+     * Accessor for the number of worker threads
+     *
+     * @return number of worker threads
+     */
+    size_t threads_count() const {
+        return workers.size();
+    }
+
+private:
+    void schedule(task_type* task) {
+        worker* self = current_worker();
+        if (nullptr != self) {
+            self->deque.push(task);
+        } else {
+            injection_queue.emplace(task);
+        }
+        idle_ec.notify_one();
+    }
+
+    // linear scan is cheap for the expected numbers of workers
+    // and does not require thread-local storage
+    worker* current_worker() {
+        auto id = std::this_thread::get_id();
+        for (auto& wo : workers) {
+            if (id == wo->thread_id) {
+                return wo.get();
+            }
+        }
+        return nullptr;
+    }
+
+    bool find_task(worker& self, task_type*& task) {
+        if (self.deque.pop(task)) {
+            return true;
+        }
+        // xorshift
+        self.rng_state ^= self.rng_state << 13;
+        self.rng_state ^= self.rng_state >> 7;
+        self.rng_state ^= self.rng_state << 17;
+        size_t count = workers.size();
+        size_t start = static_cast<size_t>(self.rng_state % count);
+        for (size_t i = 0; i < count; i++) {
+            worker& victim = *workers[(start + i) % count];
+            if (&victim != &self && victim.deque.steal(task)) {
+                return true;
+            }
+        }
+        return injection_queue.poll(task);
+    }
+
+    bool run_one(worker& self) {
+        task_type* task = nullptr;
+        if (!find_task(self, task)) {
+            return false;
+        }
+        task->run();
+        delete task;
+        return true;
+    }
+
+    bool has_work() {
+        for (auto& wo : workers) {
+            if (!wo->deque.empty()) {
+                return true;
+            }
+        }
+        return !injection_queue.empty();
+    }
+
+    void worker_loop(worker& self) {
+        // thread ids are accessed by 'current_worker'
+        idle_ec.await([this] {
+            return this->started.load(std::memory_order_acquire);
+        });
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (run_one(self)) {
+                continue;
+            }
+            // spin a little before parking
+            bool found = false;
+            for (size_t i = 0; i < 16 && !found; i++) {
+                std::this_thread::yield();
+                found = has_work();
+            }
+            if (found) {
+                continue;
+            }
+            auto key = idle_ec.prepare_wait();
+            if (stopping.load(std::memory_order_seq_cst) || has_work()) {
+                idle_ec.cancel_wait();
+                continue;
+            }
+            idle_ec.wait(key);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_FORK_JOIN_POOL_HPP */
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   inplace_task.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:10 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_INPLACE_TASK_HPP
+#define STATICLIB_CONCURRENT_INPLACE_TASK_HPP
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_inplace_task {
+
+class task_ops {
+public:
+    void (*invoke)(void* storage);
+    void (*move)(void* dest, void* src);
+    void (*destroy)(void* storage);
+};
+
+template<typename Func>
+class inline_ops {
+public:
+    static const task_ops table;
+
+    static void invoke(void* storage) {
+        (*static_cast<Func*> (storage))();
+    }
+
+    static void move(void* dest, void* src) {
+        Func* src_func = static_cast<Func*> (src);
+        new (dest) Func(std::move(*src_func));
+        src_func->~Func();
+    }
+
+    static void destroy(void* storage) {
+        static_cast<Func*> (storage)->~Func();
+    }
+};
+
+template<typename Func>
+const task_ops inline_ops<Func>::table = {
+    inline_ops<Func>::invoke,
+    inline_ops<Func>::move,
+    inline_ops<Func>::destroy
+};
+
+template<typename Func>
+class heap_ops {
+public:
+    static const task_ops table;
+
+    static void invoke(void* storage) {
+        (**static_cast<Func**> (storage))();
+    }
+
+    static void move(void* dest, void* src) {
+        *static_cast<Func**> (dest) = *static_cast<Func**> (src);
+    }
+
+    static void destroy(void* storage) {
+        delete *static_cast<Func**> (storage);
+    }
+};
+
+template<typename Func>
+const task_ops heap_ops<Func>::table = {
+    heap_ops<Func>::invoke,
+    heap_ops<Func>::move,
+    heap_ops<Func>::destroy
+};
+
+} // namespace
+
+/**
+ * Move-only type-erased `void()` callable that stores functors up to `Capacity`
+ * bytes inline without heap allocation, larger functors (or functors that
+ * can throw on move) are allocated on heap
+ */
+template<size_t Capacity = 64>
+class inplace_task {
+    // heap-allocated functors are stored as a pointer
+    static_assert(Capacity >= sizeof (void*), "Capacity must be large enough to store a pointer");
+
+    using storage_type = typename std::aligned_storage<Capacity>::type;
+
+    storage_type storage;
+    const detail_inplace_task::task_ops* ops = nullptr;
+
+public:
+    /**
+     * Checks whether specified functor type will be stored inline
+     */
+    template<typename Func>
+    struct fits_inline : std::integral_constant<bool,
+            sizeof (Func) <= Capacity &&
+            std::alignment_of<Func>::value <= std::alignment_of<storage_type>::value &&
+            std::is_nothrow_move_constructible<Func>::value> { };
+
+    /**
+     * Constructor, creates empty task
+     */
+    inplace_task() { }
+
+    /**
+     * Constructor
+     *
+     * @param func functor to wrap
+     */
+    template<typename Func,
+            class = typename std::enable_if<!std::is_same<
+                    typename std::decay<Func>::type, inplace_task>::value>::type>
+    inplace_task(Func&& func) {
+        emplace(std::forward<Func>(func));
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    inplace_task(const inplace_task&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    inplace_task& operator=(const inplace_task&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    inplace_task(inplace_task&& other) {
+        move_from(other);
+    }
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    inplace_task& operator=(inplace_task&& other) {
+        if (this != std::addressof(other)) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    ~inplace_task() {
+        reset();
+    }
+
+    /**
+     * Replaces the wrapped functor with the specified one
+     *
+     * @param func functor to wrap
+     */
+    template<typename Func>
+    void emplace(Func&& func) {
+        using func_type = typename std::decay<Func>::type;
+        reset();
+        construct<func_type>(std::forward<Func>(func), fits_inline<func_type>());
+    }
+
+    /**
+     * Invokes the wrapped functor, must not be called on empty task
+     */
+    void operator()() {
+        ops->invoke(std::addressof(storage));
+    }
+
+    /**
+     * Checks whether this task is not empty
+     *
+     * @return whether this task is not empty
+     */
+    explicit operator bool() const {
+        return nullptr != ops;
+    }
+
+    /**
+     * Destroys the wrapped functor making this task empty
+     */
+    void reset() {
+        if (nullptr != ops) {
+            ops->destroy(std::addressof(storage));
+            ops = nullptr;
+        }
+    }
+
+private:
+    template<typename Func, typename Arg>
+    void construct(Arg&& func, std::true_type) {
+        new (std::addressof(storage)) Func(std::forward<Arg>(func));
+        ops = std::addressof(detail_inplace_task::inline_ops<Func>::table);
+    }
+
+    template<typename Func, typename Arg>
+    void construct(Arg&& func, std::false_type) {
+        Func* ptr = new Func(std::forward<Arg>(func));
+        new (std::addressof(storage)) Func*(ptr);
+        ops = std::addressof(detail_inplace_task::heap_ops<Func>::table);
+    }
+
+    void move_from(inplace_task& other) {
+        if (nullptr != other.ops) {
+            other.ops->move(std::addressof(storage), std::addressof(other.storage));
+            ops = other.ops;
+            other.ops = nullptr;
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_INPLACE_TASK_HPP */
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   mcs_mutex.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:50 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_MCS_MUTEX_HPP
+#define STATICLIB_CONCURRENT_MCS_MUTEX_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+// based on: "Algorithms for Scalable Synchronization on Shared-Memory Multiprocessors"
+// by John M. Mellor-Crummey and Michael L. Scott, K42 variant of the MCS lock
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Fair (FIFO) queue mutex, each waiter spins (and then blocks) on its own
+ * queue node, allocated on the waiter's stack, so the lock handoff touches
+ * only the cache line of the next waiter. Owner does not need a queue node,
+ * so the mutex has the usual `lock`/`unlock` interface.
+ * Satisfies `Lockable` requirements, can be used with `std::unique_lock`
+ * and `std::condition_variable_any` (`eventcount_condition` is cheaper).
+ */
+class mcs_mutex {
+    // queue node states
+    static const uint32_t granted = 0;
+    static const uint32_t spinning = 1;
+    static const uint32_t sleeping = 2;
+    static const size_t spins_count = 100;
+
+    class qnode {
+    public:
+        std::atomic<qnode*> next;
+        std::atomic<uint32_t> state;
+
+        qnode() :
+        next(nullptr),
+        state(spinning) { }
+    };
+
+    // nullptr - unlocked, address of 'head' - locked without waiters
+    std::atomic<qnode*> tail;
+    // 'head.next' points to the owner's successor
+    qnode head;
+
+public:
+    /**
+     * Constructor
+     */
+    mcs_mutex() :
+    tail(nullptr) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    mcs_mutex(const mcs_mutex&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    mcs_mutex& operator=(const mcs_mutex&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    mcs_mutex(mcs_mutex&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    mcs_mutex& operator=(mcs_mutex&&) = delete;
+
+    /**
+     * Locks the mutex, blocks if the mutex is not available
+     */
+    void lock() {
+        qnode* marker = std::addressof(head);
+        for (;;) {
+            qnode* prev = tail.load(std::memory_order_relaxed);
+            if (nullptr == prev) {
+                if (tail.compare_exchange_weak(prev, marker, std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            qnode me;
+            qnode* me_ptr = std::addressof(me);
+            if (!tail.compare_exchange_weak(prev, me_ptr, std::memory_order_acq_rel,
+                    std::memory_order_relaxed)) {
+                continue;
+            }
+            prev->next.store(me_ptr, std::memory_order_release);
+            await_handoff(me);
+            // node is going out of scope, pass the successor to the 'head'
+            qnode* succ = me.next.load(std::memory_order_acquire);
+            if (nullptr == succ) {
+                head.next.store(nullptr, std::memory_order_relaxed);
+                qnode* expected = me_ptr;
+                if (!tail.compare_exchange_strong(expected, marker, std::memory_order_acq_rel,
+                        std::memory_order_relaxed)) {
+                    // successor is linking itself to this node
+                    succ = wait_next(me);
+                    head.next.store(succ, std::memory_order_relaxed);
+                }
+            } else {
+                head.next.store(succ, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+
+    /**
+     * Tries to lock the mutex, returns immediately
+     *
+     * @return true if the mutex was locked, false otherwise
+     */
+    bool try_lock() {
+        qnode* expected = nullptr;
+        return tail.compare_exchange_strong(expected, std::addressof(head), std::memory_order_acquire,
+                std::memory_order_relaxed);
+    }
+
+    /**
+     * Unlocks the mutex
+     */
+    void unlock() {
+        qnode* succ = head.next.load(std::memory_order_acquire);
+        if (nullptr == succ) {
+            qnode* expected = std::addressof(head);
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                    std::memory_order_relaxed)) {
+                return;
+            }
+            succ = wait_next(head);
+        }
+        // successor's node may be destroyed right after the handoff, only its address is used
+        std::atomic<uint32_t>& st = succ->state;
+        if (sleeping == st.exchange(granted, std::memory_order_acq_rel)) {
+            atomic_notify_one(st);
+        }
+    }
+
+private:
+    static qnode* wait_next(qnode& node) {
+        qnode* res = node.next.load(std::memory_order_acquire);
+        while (nullptr == res) {
+            res = node.next.load(std::memory_order_acquire);
+        }
+        return res;
+    }
+
+    static void await_handoff(qnode& node) {
+        for (size_t i = 0; i < spins_count; i++) {
+            if (granted == node.state.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+        uint32_t expected = spinning;
+        if (node.state.compare_exchange_strong(expected, sleeping, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            atomic_wait(node.state, sleeping);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_MCS_MUTEX_HPP */
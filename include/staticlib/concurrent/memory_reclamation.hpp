@@ -0,0 +1,757 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   memory_reclamation.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:00 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_MEMORY_RECLAMATION_HPP
+#define STATICLIB_CONCURRENT_MEMORY_RECLAMATION_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// based on: "Practical lock-freedom" by Keir Fraser (epochs) and
+// "Hazard Pointers: Safe Memory Reclamation for Lock-Free Objects" by Maged M. Michael
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_memory_reclamation {
+
+// retired object with type-erased reclaim function, context may point to a pool
+class retired_node {
+public:
+    void* ptr;
+    void (*reclaim)(void* ptr, void* ctx);
+    void* ctx;
+
+    retired_node(void* ptr, void (*reclaim)(void*, void*), void* ctx) :
+    ptr(ptr),
+    reclaim(reclaim),
+    ctx(ctx) { }
+
+    void operator()() const {
+        reclaim(ptr, ctx);
+    }
+};
+
+template<typename T>
+void delete_object(void* ptr, void*) {
+    delete static_cast<T*> (ptr);
+}
+
+inline void reclaim_all(std::vector<retired_node>& nodes) {
+    for (const retired_node& nd : nodes) {
+        nd();
+    }
+    nodes.clear();
+}
+
+// participant records are never deleted before the domain, only reused
+// new record is fully constructed before it is published
+template<typename Record, typename... Args>
+Record* acquire_record(std::atomic<Record*>& head, Args&&... args) {
+    for (Record* rec = head.load(std::memory_order_acquire); nullptr != rec; rec = rec->next) {
+        bool expected = false;
+        if (!rec->in_use.load(std::memory_order_relaxed) &&
+                rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire,
+                std::memory_order_relaxed)) {
+            return rec;
+        }
+    }
+    Record* rec = new Record(std::forward<Args>(args)...);
+    rec->in_use.store(true, std::memory_order_relaxed);
+    Record* next = head.load(std::memory_order_relaxed);
+    do {
+        rec->next = next;
+    } while (!head.compare_exchange_weak(next, rec, std::memory_order_release, std::memory_order_relaxed));
+    return rec;
+}
+
+template<typename Record>
+void delete_records(std::atomic<Record*>& head) {
+    Record* rec = head.load(std::memory_order_acquire);
+    while (nullptr != rec) {
+        Record* next = rec->next;
+        delete rec;
+        rec = next;
+    }
+}
+
+} // namespace
+
+/**
+ * Epoch-based memory reclamation domain for lock-free data structures.
+ * Each thread registers a `participant`, pins it while accessing shared
+ * nodes and retires unlinked nodes instead of deleting them. Retired nodes
+ * are reclaimed when the global epoch advances twice, that happens only
+ * when all the pinned participants have observed the current epoch. Pinning
+ * is cheap (a store and a fence on participant's own cache line), but a thread
+ * stalled while pinned stops the reclamation for everybody. Participants
+ * and pinned guards must be used only by the thread that created them.
+ */
+class epoch_domain : public std::enable_shared_from_this<epoch_domain> {
+    using retired_node = detail_memory_reclamation::retired_node;
+
+public:
+    class participant;
+
+private:
+    class record {
+    public:
+        // (epoch << 1) | pinned
+        std::atomic<uint64_t> state;
+        std::atomic<bool> in_use;
+        record* next = nullptr;
+        // owner thread only
+        size_t pin_depth = 0;
+        std::vector<retired_node> bags[3];
+        uint64_t bag_epochs[3];
+        size_t retired_count = 0;
+        size_t collect_at = 0;
+        char padding[64];
+
+        record() :
+        state(0),
+        in_use(false) {
+            bag_epochs[0] = 0;
+            bag_epochs[1] = 0;
+            bag_epochs[2] = 0;
+        }
+    };
+
+    const size_t retire_batch;
+    std::atomic<uint64_t> global_epoch;
+    std::atomic<record*> records_head;
+    std::mutex orphans_mutex;
+    std::vector<std::pair<uint64_t, retired_node>> orphans;
+
+public:
+    /**
+     * Read-side guard, keeps participant pinned until destroyed
+     */
+    class guard {
+        friend class participant;
+
+        record* rec;
+
+        explicit guard(record* rec) :
+        rec(rec) { }
+
+    public:
+        /**
+         * Destructor, unpins the participant
+         */
+        ~guard() {
+            if (nullptr != rec && 0 == --rec->pin_depth) {
+                rec->state.store(0, std::memory_order_release);
+            }
+        }
+
+        /**
+         * Deleted copy constructor
+         */
+        guard(const guard&) = delete;
+
+        /**
+         * Deleted copy assignment operator
+         */
+        guard& operator=(const guard&) = delete;
+
+        /**
+         * Move constructor
+         *
+         * @param other other instance
+         */
+        guard(guard&& other) :
+        rec(other.rec) {
+            other.rec = nullptr;
+        }
+
+        /**
+         * Deleted move assignment operator
+         */
+        guard& operator=(guard&&) = delete;
+    };
+
+    /**
+     * Registered thread, must be destroyed before the domain
+     */
+    class participant {
+        friend class epoch_domain;
+
+        epoch_domain* domain;
+        record* rec;
+
+        participant(epoch_domain* domain, record* rec) :
+        domain(domain),
+        rec(rec) { }
+
+    public:
+        /**
+         * Destructor, unregisters the thread, its retired nodes
+         * are handed over to the domain
+         */
+        ~participant() {
+            if (nullptr != rec) {
+                domain->unregister(*rec);
+            }
+        }
+
+        /**
+         * Deleted copy constructor
+         */
+        participant(const participant&) = delete;
+
+        /**
+         * Deleted copy assignment operator
+         */
+        participant& operator=(const participant&) = delete;
+
+        /**
+         * Move constructor
+         *
+         * @param other other instance
+         */
+        participant(participant&& other) :
+        domain(other.domain),
+        rec(other.rec) {
+            other.rec = nullptr;
+        }
+
+        /**
+         * Deleted move assignment operator
+         */
+        participant& operator=(participant&&) = delete;
+
+        /**
+         * Pins this participant in current epoch, shared nodes can be accessed
+         * while the returned guard is alive, pins can be nested
+         *
+         * @return guard object
+         */
+        guard pin() {
+            if (0 == rec->pin_depth++) {
+                uint64_t epoch = domain->global_epoch.load(std::memory_order_relaxed);
+                rec->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+            return guard(rec);
+        }
+
+        /**
+         * Retires an object, that was allocated with `new`,
+         * it will be deleted when no thread can access it
+         *
+         * @param ptr object to retire
+         */
+        template<typename T>
+        void retire(T* ptr) {
+            retire(static_cast<void*> (ptr), detail_memory_reclamation::delete_object<T>, nullptr);
+        }
+
+        /**
+         * Retires an object with custom reclaim function, it will be
+         * called when no thread can access the object
+         *
+         * @param ptr object to retire
+         * @param reclaim function to call with object and context pointers
+         * @param ctx context pointer (for example, a pool), may be null
+         */
+        void retire(void* ptr, void (*reclaim)(void*, void*), void* ctx) {
+            domain->retire(*rec, retired_node(ptr, reclaim, ctx));
+        }
+
+        /**
+         * Tries to advance the global epoch and reclaims
+         * retired objects that became unreachable
+         *
+         * @return number of reclaimed objects
+         */
+        size_t collect() {
+            return domain->collect(*rec);
+        }
+
+        /**
+         * Returns the number of objects retired by this
+         * participant and not reclaimed yet
+         *
+         * @return number of retired objects
+         */
+        size_t retired_count() const {
+            return rec->retired_count;
+        }
+    };
+
+    /**
+     * Constructor
+     *
+     * @param retire_batch number of objects retired by participant,
+     *        after which it tries to advance the epoch and reclaim them
+     */
+    explicit epoch_domain(size_t retire_batch = 64) :
+    retire_batch(retire_batch > 0 ? retire_batch : 1),
+    global_epoch(0),
+    records_head(nullptr) { }
+
+    /**
+     * Destructor, reclaims all the retired objects,
+     * all the participants must be destroyed at this point
+     */
+    ~epoch_domain() {
+        for (record* rec = records_head.load(std::memory_order_acquire); nullptr != rec; rec = rec->next) {
+            for (size_t i = 0; i < 3; i++) {
+                detail_memory_reclamation::reclaim_all(rec->bags[i]);
+            }
+        }
+        for (auto& en : orphans) {
+            en.second();
+        }
+        detail_memory_reclamation::delete_records(records_head);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    epoch_domain(const epoch_domain&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    epoch_domain(epoch_domain&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    epoch_domain& operator=(epoch_domain&&) = delete;
+
+    /**
+     * Registers calling thread in this domain
+     *
+     * @return participant object
+     */
+    participant register_thread() {
+        return participant(this, detail_memory_reclamation::acquire_record(records_head));
+    }
+
+    /**
+     * Returns current global epoch
+     *
+     * @return global epoch
+     */
+    uint64_t epoch() const {
+        return global_epoch.load(std::memory_order_acquire);
+    }
+
+private:
+    void retire(record& rec, retired_node node) {
+        uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+        size_t idx = static_cast<size_t> (epoch % 3);
+        if (rec.bag_epochs[idx] != epoch) {
+            // bag holds objects retired at least 3 epochs ago
+            rec.retired_count -= rec.bags[idx].size();
+            detail_memory_reclamation::reclaim_all(rec.bags[idx]);
+            rec.bag_epochs[idx] = epoch;
+        }
+        rec.bags[idx].push_back(node);
+        rec.retired_count += 1;
+        if (rec.retired_count >= rec.collect_at) {
+            collect(rec);
+            // amortized, even if some participant stalls while pinned
+            rec.collect_at = rec.retired_count + retire_batch;
+        }
+    }
+
+    size_t collect(record& rec) {
+        try_advance();
+        uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+        size_t res = 0;
+        for (size_t i = 0; i < 3; i++) {
+            std::vector<retired_node>& bag = rec.bags[i];
+            if (!bag.empty() && rec.bag_epochs[i] + 2 <= epoch) {
+                res += bag.size();
+                rec.retired_count -= bag.size();
+                detail_memory_reclamation::reclaim_all(bag);
+            }
+        }
+        res += collect_orphans(epoch);
+        return res;
+    }
+
+    bool try_advance() {
+        uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (record* rec = records_head.load(std::memory_order_acquire); nullptr != rec; rec = rec->next) {
+            uint64_t st = rec->state.load(std::memory_order_relaxed);
+            if (1 == (st & 1) && (st >> 1) != epoch) {
+                return false;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release,
+                std::memory_order_relaxed);
+    }
+
+    size_t collect_orphans(uint64_t epoch) {
+        std::unique_lock<std::mutex> guard{orphans_mutex, std::try_to_lock};
+        if (!guard.owns_lock() || orphans.empty()) {
+            return 0;
+        }
+        auto it = std::partition(orphans.begin(), orphans.end(),
+                [epoch](const std::pair<uint64_t, retired_node>& en) {
+                    return en.first + 2 > epoch;
+                });
+        size_t res = static_cast<size_t> (orphans.end() - it);
+        for (auto rit = it; rit != orphans.end(); ++rit) {
+            rit->second();
+        }
+        orphans.erase(it, orphans.end());
+        return res;
+    }
+
+    void unregister(record& rec) {
+        collect(rec);
+        {
+            std::lock_guard<std::mutex> guard{orphans_mutex};
+            for (size_t i = 0; i < 3; i++) {
+                for (const retired_node& nd : rec.bags[i]) {
+                    orphans.emplace_back(rec.bag_epochs[i], nd);
+                }
+                rec.bags[i].clear();
+            }
+        }
+        rec.retired_count = 0;
+        rec.collect_at = 0;
+        rec.pin_depth = 0;
+        rec.state.store(0, std::memory_order_relaxed);
+        rec.in_use.store(false, std::memory_order_release);
+    }
+
+};
+
+/**
+ * Hazard pointers memory reclamation domain for lock-free data structures.
+ * Each thread registers a `participant` and publishes the pointers to shared
+ * nodes it accesses in its hazard slots. Retired nodes are reclaimed in batches
+ * by scanning the hazard slots of all the participants, node is reclaimed
+ * when no slot points to it. Unlike epochs, the number of unreclaimed nodes
+ * is bounded even if some thread stalls, at the cost of a fence per protected
+ * pointer. Participants must be used only by the thread that created them.
+ */
+class hazard_domain : public std::enable_shared_from_this<hazard_domain> {
+    using retired_node = detail_memory_reclamation::retired_node;
+
+public:
+    class participant;
+
+private:
+    class record {
+    public:
+        // allocated before the record is published, immutable after that
+        const std::unique_ptr<std::atomic<void*>[]> hazards;
+        std::atomic<bool> in_use;
+        record* next = nullptr;
+        // owner thread only
+        std::vector<retired_node> retired;
+        char padding[64];
+
+        record(size_t hazards_count, std::atomic<size_t>& records_count) :
+        hazards(new std::atomic<void*>[hazards_count]),
+        in_use(false) {
+            for (size_t i = 0; i < hazards_count; i++) {
+                hazards[i].store(nullptr, std::memory_order_relaxed);
+            }
+            records_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    const size_t hazards_count;
+    const size_t retire_batch;
+    std::atomic<record*> records_head;
+    std::atomic<size_t> records_count;
+    std::mutex orphans_mutex;
+    std::vector<retired_node> orphans;
+
+public:
+    /**
+     * Registered thread, must be destroyed before the domain
+     */
+    class participant {
+        friend class hazard_domain;
+
+        hazard_domain* domain;
+        record* rec;
+
+        participant(hazard_domain* domain, record* rec) :
+        domain(domain),
+        rec(rec) { }
+
+    public:
+        /**
+         * Destructor, unregisters the thread, its retired nodes
+         * are handed over to the domain
+         */
+        ~participant() {
+            if (nullptr != rec) {
+                domain->unregister(*rec);
+            }
+        }
+
+        /**
+         * Deleted copy constructor
+         */
+        participant(const participant&) = delete;
+
+        /**
+         * Deleted copy assignment operator
+         */
+        participant& operator=(const participant&) = delete;
+
+        /**
+         * Move constructor
+         *
+         * @param other other instance
+         */
+        participant(participant&& other) :
+        domain(other.domain),
+        rec(other.rec) {
+            other.rec = nullptr;
+        }
+
+        /**
+         * Deleted move assignment operator
+         */
+        participant& operator=(participant&&) = delete;
+
+        /**
+         * Loads the pointer from the specified atomic and protects
+         * it in the specified hazard slot, protected node is not
+         * reclaimed until the slot is cleared or reused
+         *
+         * @param slot hazard slot index
+         * @param src atomic pointer to load
+         * @return protected pointer
+         */
+        template<typename T>
+        T* protect(size_t slot, const std::atomic<T*>& src) {
+            std::atomic<void*>& hz = rec->hazards[slot];
+            T* ptr = src.load(std::memory_order_relaxed);
+            for (;;) {
+                hz.store(static_cast<void*> (ptr), std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                T* reloaded = src.load(std::memory_order_acquire);
+                if (reloaded == ptr) {
+                    return ptr;
+                }
+                ptr = reloaded;
+            }
+        }
+
+        /**
+         * Publishes the pointer, that is known to be reachable,
+         * in the specified hazard slot
+         *
+         * @param slot hazard slot index
+         * @param ptr pointer to protect
+         */
+        void set(size_t slot, const void* ptr) {
+            rec->hazards[slot].store(const_cast<void*> (ptr), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /**
+         * Clears the specified hazard slot
+         *
+         * @param slot hazard slot index
+         */
+        void clear(size_t slot) {
+            rec->hazards[slot].store(nullptr, std::memory_order_release);
+        }
+
+        /**
+         * Retires an object, that was allocated with `new`,
+         * it will be deleted when no hazard slot points to it
+         *
+         * @param ptr object to retire
+         */
+        template<typename T>
+        void retire(T* ptr) {
+            retire(static_cast<void*> (ptr), detail_memory_reclamation::delete_object<T>, nullptr);
+        }
+
+        /**
+         * Retires an object with custom reclaim function, it will be
+         * called when no hazard slot points to the object
+         *
+         * @param ptr object to retire
+         * @param reclaim function to call with object and context pointers
+         * @param ctx context pointer (for example, a pool), may be null
+         */
+        void retire(void* ptr, void (*reclaim)(void*, void*), void* ctx) {
+            rec->retired.emplace_back(ptr, reclaim, ctx);
+            if (rec->retired.size() >= domain->scan_threshold()) {
+                domain->scan(*rec);
+            }
+        }
+
+        /**
+         * Reclaims retired objects that are not protected
+         *
+         * @return number of reclaimed objects
+         */
+        size_t collect() {
+            return domain->scan(*rec);
+        }
+
+        /**
+         * Returns the number of objects retired by this
+         * participant and not reclaimed yet
+         *
+         * @return number of retired objects
+         */
+        size_t retired_count() const {
+            return rec->retired.size();
+        }
+    };
+
+    /**
+     * Constructor
+     *
+     * @param hazards_count number of hazard slots for each participant
+     * @param retire_batch min number of objects retired by participant,
+     *        after which it scans the hazard slots, actual threshold
+     *        grows with the total number of hazard slots
+     */
+    explicit hazard_domain(size_t hazards_count = 2, size_t retire_batch = 64) :
+    hazards_count(hazards_count > 0 ? hazards_count : 1),
+    retire_batch(retire_batch > 0 ? retire_batch : 1),
+    records_head(nullptr),
+    records_count(0) { }
+
+    /**
+     * Destructor, reclaims all the retired objects,
+     * all the participants must be destroyed at this point
+     */
+    ~hazard_domain() {
+        for (record* rec = records_head.load(std::memory_order_acquire); nullptr != rec; rec = rec->next) {
+            detail_memory_reclamation::reclaim_all(rec->retired);
+        }
+        detail_memory_reclamation::reclaim_all(orphans);
+        detail_memory_reclamation::delete_records(records_head);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    hazard_domain(const hazard_domain&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    hazard_domain& operator=(const hazard_domain&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    hazard_domain(hazard_domain&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    hazard_domain& operator=(hazard_domain&&) = delete;
+
+    /**
+     * Registers calling thread in this domain
+     *
+     * @return participant object
+     */
+    participant register_thread() {
+        record* rec = detail_memory_reclamation::acquire_record(records_head, hazards_count, records_count);
+        return participant(this, rec);
+    }
+
+private:
+    size_t scan_threshold() const {
+        // amortized constant time per retired object
+        size_t hazards_total = records_count.load(std::memory_order_relaxed) * hazards_count;
+        return std::max(retire_batch, 2 * hazards_total);
+    }
+
+    size_t scan(record& rec) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<void*> protected_ptrs;
+        for (record* re = records_head.load(std::memory_order_acquire); nullptr != re; re = re->next) {
+            for (size_t i = 0; i < hazards_count; i++) {
+                void* ptr = re->hazards[i].load(std::memory_order_acquire);
+                if (nullptr != ptr) {
+                    protected_ptrs.push_back(ptr);
+                }
+            }
+        }
+        std::sort(protected_ptrs.begin(), protected_ptrs.end());
+        size_t res = reclaim_unprotected(rec.retired, protected_ptrs);
+        std::unique_lock<std::mutex> guard{orphans_mutex, std::try_to_lock};
+        if (guard.owns_lock()) {
+            res += reclaim_unprotected(orphans, protected_ptrs);
+        }
+        return res;
+    }
+
+    static size_t reclaim_unprotected(std::vector<retired_node>& nodes, const std::vector<void*>& protected_ptrs) {
+        auto it = std::partition(nodes.begin(), nodes.end(), [&protected_ptrs](const retired_node& nd) {
+            return std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), nd.ptr);
+        });
+        size_t res = static_cast<size_t> (nodes.end() - it);
+        for (auto rit = it; rit != nodes.end(); ++rit) {
+            (*rit)();
+        }
+        nodes.erase(it, nodes.end());
+        return res;
+    }
+
+    void unregister(record& rec) {
+        for (size_t i = 0; i < hazards_count; i++) {
+            rec.hazards[i].store(nullptr, std::memory_order_release);
+        }
+        scan(rec);
+        if (!rec.retired.empty()) {
+            std::lock_guard<std::mutex> guard{orphans_mutex};
+            orphans.insert(orphans.end(), rec.retired.begin(), rec.retired.end());
+            rec.retired.clear();
+        }
+        rec.in_use.store(false, std::memory_order_release);
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_MEMORY_RECLAMATION_HPP */
@@ -31,20 +31,31 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <type_traits>
+
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/readiness_notifier.hpp"
 
 namespace staticlib {
 namespace concurrent {
 
 /**
  * Optionally bounded growing FIFO blocking queue with support for blocking and 
- * non-blocking multiple consumers and always non-blocking multiple producers
+ * non-blocking multiple consumers and always non-blocking multiple producers,
+ * `Mutex` can be any `Lockable` type (`spin_mutex`, `ticket_mutex`, `mcs_mutex`),
+ * `eventcount_condition` is used for waiting with mutexes other than `std::mutex`,
+ * `Notifier` (`eventfd_notifier`) allows to wait for elements in `epoll` loop
  */
-template<typename T>
-class mpmc_blocking_queue : public std::enable_shared_from_this<mpmc_blocking_queue<T>> {
-    mutable std::mutex mutex;
-    std::condition_variable empty_cv;
+template<typename T, typename Mutex = std::mutex, typename Notifier = null_notifier>
+class mpmc_blocking_queue : public std::enable_shared_from_this<mpmc_blocking_queue<T, Mutex, Notifier>> {
+    using cv_type = typename std::conditional<std::is_same<Mutex, std::mutex>::value,
+            std::condition_variable, eventcount_condition>::type;
+
+    mutable Mutex mutex;
+    cv_type empty_cv;
     std::deque<T> queue;
     const size_t max_queue_size;
+    Notifier readiness;
     bool unblocked = false;
     
 public:
@@ -84,12 +95,13 @@ public:
      */
     template<typename ...Args>
     bool emplace(Args&&... record_args) {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         auto size = queue.size();
         if (0 == max_queue_size || size < max_queue_size) {
             queue.emplace_back(std::forward<Args>(record_args)...);
             if (0 == size) {
                 empty_cv.notify_all();
+                readiness.notify();
             }
             return true;
         } else {
@@ -107,7 +119,7 @@ public:
     template<typename Range,
             class = typename std::enable_if<!std::is_lvalue_reference<Range>::value>::type>
     size_t emplace_range(Range&& range) {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         auto origin_size = queue.size();
         for (auto&& el : range) {
             if (0 == max_queue_size || queue.size() < max_queue_size) {
@@ -116,8 +128,9 @@ public:
                 break;
             }
         }
-        if (0 == origin_size) {
+        if (0 == origin_size && queue.size() > 0) {
             empty_cv.notify_all();
+            readiness.notify();
         }
         return queue.size() - origin_size;
     }
@@ -131,7 +144,7 @@ public:
      */
     template<typename Range>
     size_t emplace_range(Range& range) {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         auto origin_size = queue.size();
         for (auto& el : range) {
             if (0 == max_queue_size || queue.size() < max_queue_size) {
@@ -140,8 +153,9 @@ public:
                 break;
             }
         }
-        if (0 == origin_size) {
+        if (0 == origin_size && queue.size() > 0) {
             empty_cv.notify_all();
+            readiness.notify();
         }
         return queue.size() - origin_size;
     }
@@ -154,7 +168,7 @@ public:
      * @return returns false if queue was empty, true otherwise
      */
     bool poll(T& record) {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         if (!queue.empty()) {
             record = std::move(queue.front());
             queue.pop_front();
@@ -173,7 +187,7 @@ public:
      */
     template<typename Func>
     size_t poll(Func&& func) {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         auto origin_size = queue.size();
         while (!queue.empty()) {
             T record = std::move(queue.front());
@@ -194,7 +208,7 @@ public:
      * @return returns false if queue was empty after timeout, true otherwise
      */
     bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
-        std::unique_lock<std::mutex> guard{mutex};
+        std::unique_lock<Mutex> guard{mutex};
         if (!queue.empty()) {
             record = std::move(queue.front());
             queue.pop_front();
@@ -224,11 +238,12 @@ public:
      * for waiting on it after this call.
      */
     void unblock() {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         this->unblocked = true;
         if (queue.empty()) {
             empty_cv.notify_all();
         }
+        readiness.notify();
     }
 
     /**
@@ -237,7 +252,7 @@ public:
      * @return whether this queue was unblocked
      */
     bool is_unblocked() const {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         return unblocked;
     }
 
@@ -247,7 +262,7 @@ public:
      * @return whether queue is empty
      */
     bool empty() const {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         return queue.empty();
     }
 
@@ -257,7 +272,7 @@ public:
      * @return whether queue is full
      */
     bool full() const {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         if (0 == max_queue_size) {
             return false;
         }
@@ -270,7 +285,7 @@ public:
      * @return number of entries in the queue
      */
     size_t size() const {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         return queue.size();
     }
 
@@ -283,6 +298,16 @@ public:
         return max_queue_size;
     }
 
+    /**
+     * Accessor for the readiness notifier, that is signalled
+     * when elements become available or when the queue is unblocked
+     *
+     * @return readiness notifier
+     */
+    Notifier& notifier() {
+        return readiness;
+    }
+
 };
 
 } // namespace
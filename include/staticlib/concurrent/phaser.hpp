@@ -0,0 +1,343 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   phaser.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:40 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_PHASER_HPP
+#define STATICLIB_CONCURRENT_PHASER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+// based on: java.util.concurrent.Phaser
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Reusable synchronization barrier with the dynamic number of parties.
+ * Parties can be registered and deregistered at any time, phase advances
+ * when all the registered parties arrive. Phaser state (phase number,
+ * number of parties and number of unarrived parties) is kept in a single
+ * atomic word. Phasers can be tiered: child phaser is registered in
+ * its parent as a single party and arrives at the parent when all its own
+ * parties arrive, this way large number of parties can be split into
+ * multiple phasers to reduce contention. Phase number is shared by
+ * all the phasers in a tree. Single phaser supports up to 65535 parties.
+ */
+class phaser : public std::enable_shared_from_this<phaser> {
+    // state layout: phase - bits 0-31 (futex word), parties - bits 32-47, unarrived - bits 48-63
+    static const size_t spins_count = 128;
+    static const uint32_t max_parties = 0xFFFF;
+
+    phaser* const parent;
+    std::atomic<uint64_t> state;
+    std::mutex parent_mutex;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param parties initial number of registered parties
+     * @throws std::invalid_argument if number of parties exceeds 65535
+     */
+    explicit phaser(uint32_t parties = 0) :
+    parent(nullptr),
+    state(make_state(0, checked_parties(0, parties), parties)) { }
+
+    /**
+     * Constructor for the tiered phaser, this phaser is registered
+     * in parent when it has at least one party registered
+     *
+     * @param parent parent phaser, must outlive this phaser
+     * @param parties initial number of registered parties, may be zero
+     * @throws std::invalid_argument if number of parties exceeds 65535
+     */
+    phaser(phaser& parent, uint32_t parties) :
+    parent(std::addressof(parent)),
+    state(make_state(0, 0, 0)) {
+        if (parties > 0) {
+            bulk_register(parties);
+        } else {
+            state.store(make_state(parent.phase(), 0, 0), std::memory_order_release);
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    phaser(const phaser&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    phaser& operator=(const phaser&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    phaser(phaser&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    phaser& operator=(phaser&&) = delete;
+
+    /**
+     * Registers a new party
+     *
+     * @return phase number at the time of registration
+     * @throws std::invalid_argument if number of parties exceeds 65535
+     */
+    uint32_t register_party() {
+        return bulk_register(1);
+    }
+
+    /**
+     * Registers specified number of new parties
+     *
+     * @param count number of parties to register
+     * @return phase number at the time of registration
+     * @throws std::invalid_argument if number of parties exceeds 65535
+     */
+    uint32_t bulk_register(uint32_t count) {
+        if (0 == count) {
+            return phase();
+        }
+        checked_parties(0, count);
+        for (;;) {
+            uint64_t st = state.load(std::memory_order_acquire);
+            if (nullptr != parent && 0 == state_parties(st)) {
+                // first registration in a child, register it in parent
+                std::lock_guard<std::mutex> guard{parent_mutex};
+                st = state.load(std::memory_order_acquire);
+                if (0 == state_parties(st)) {
+                    uint32_t ph = parent->register_party();
+                    state.store(make_state(ph, count, count), std::memory_order_release);
+                    return ph;
+                }
+                continue;
+            }
+            if (nullptr != parent && 0 == state_unarrived(st)) {
+                // child waits for the parent to advance
+                sync_with_parent(st);
+                continue;
+            }
+            uint64_t updated = make_state(state_phase(st), checked_parties(state_parties(st), count),
+                    state_unarrived(st) + count);
+            if (state.compare_exchange_weak(st, updated, std::memory_order_acq_rel)) {
+                return state_phase(st);
+            }
+        }
+    }
+
+    /**
+     * Arrives at this phaser without waiting for others to arrive
+     *
+     * @return arrival phase number
+     * @throws std::logic_error if there are no unarrived parties
+     */
+    uint32_t arrive() {
+        return do_arrive(false);
+    }
+
+    /**
+     * Arrives at this phaser and deregisters from it
+     * without waiting for others to arrive
+     *
+     * @return arrival phase number
+     * @throws std::logic_error if there are no unarrived parties
+     */
+    uint32_t arrive_and_deregister() {
+        return do_arrive(true);
+    }
+
+    /**
+     * Arrives at this phaser and waits for others
+     *
+     * @return phase number after the advance
+     * @throws std::logic_error if there are no unarrived parties
+     */
+    uint32_t arrive_and_wait() {
+        return await_phase(do_arrive(false));
+    }
+
+    /**
+     * Waits for the phase of this phaser to advance from the given
+     * phase value, returns immediately if the current phase
+     * is not equal to the given one
+     *
+     * @param phase_num arrival phase number
+     * @return next phase number
+     */
+    uint32_t await_phase(uint32_t phase_num) {
+        for (size_t i = 0; ; i++) {
+            uint64_t st = state.load(std::memory_order_acquire);
+            if (phase_num != state_phase(st)) {
+                return state_phase(st);
+            }
+            if (nullptr != parent && 0 == state_unarrived(st) && state_parties(st) > 0) {
+                sync_with_parent(st);
+                continue;
+            }
+            if (i < spins_count) {
+                std::this_thread::yield();
+            } else {
+                atomic_wait(state, st);
+            }
+        }
+    }
+
+    /**
+     * Returns current phase number
+     *
+     * @return current phase number
+     */
+    uint32_t phase() const {
+        return state_phase(state.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of registered parties
+     *
+     * @return number of registered parties
+     */
+    uint32_t registered_parties() const {
+        return state_parties(state.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of parties that have not yet arrived in current phase
+     *
+     * @return number of unarrived parties
+     */
+    uint32_t unarrived_parties() const {
+        return state_unarrived(state.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of arrived parties in current phase
+     *
+     * @return number of arrived parties
+     */
+    uint32_t arrived_parties() const {
+        uint64_t st = state.load(std::memory_order_acquire);
+        return state_parties(st) - state_unarrived(st);
+    }
+
+private:
+    static uint32_t checked_parties(uint32_t registered, uint32_t count) {
+        if (count > max_parties - registered) {
+            throw std::invalid_argument("Too many parties registered in 'phaser'," +
+                    std::string(" registered: ") + std::to_string(registered) +
+                    ", requested: " + std::to_string(count) +
+                    ", max: " + std::to_string(max_parties));
+        }
+        return registered + count;
+    }
+
+    static uint64_t make_state(uint32_t phase_num, uint32_t parties, uint32_t unarrived) {
+        return static_cast<uint64_t> (phase_num) |
+                (static_cast<uint64_t> (parties & 0xFFFF) << 32) |
+                (static_cast<uint64_t> (unarrived & 0xFFFF) << 48);
+    }
+
+    static uint32_t state_phase(uint64_t st) {
+        return static_cast<uint32_t> (st & 0xFFFFFFFF);
+    }
+
+    static uint32_t state_parties(uint64_t st) {
+        return static_cast<uint32_t> ((st >> 32) & 0xFFFF);
+    }
+
+    static uint32_t state_unarrived(uint64_t st) {
+        return static_cast<uint32_t> ((st >> 48) & 0xFFFF);
+    }
+
+    uint32_t do_arrive(bool deregister) {
+        // read before the arrival, phaser may be destroyed after it
+        phaser* par = parent;
+        for (;;) {
+            uint64_t st = state.load(std::memory_order_acquire);
+            uint32_t ph = state_phase(st);
+            uint32_t parties = state_parties(st);
+            uint32_t unarrived = state_unarrived(st);
+            if (nullptr != par && 0 == unarrived && parties > 0) {
+                sync_with_parent(st);
+                continue;
+            }
+            if (0 == unarrived) {
+                throw std::logic_error("Arrival at 'phaser' without unarrived parties," +
+                        std::string(" registered parties: ") + std::to_string(parties));
+            }
+            uint32_t next_parties = deregister ? parties - 1 : parties;
+            uint32_t next_unarrived = unarrived - 1;
+            uint64_t updated = 0;
+            bool completes = 0 == next_unarrived;
+            if (!completes) {
+                updated = make_state(ph, next_parties, next_unarrived);
+            } else if (nullptr == par) {
+                // root advances immediately
+                updated = make_state(ph + 1, next_parties, next_parties);
+            } else {
+                // child waits for the parent to advance
+                updated = make_state(ph, next_parties, 0);
+            }
+            if (!state.compare_exchange_weak(st, updated, std::memory_order_acq_rel)) {
+                continue;
+            }
+            if (completes) {
+                atomic_notify_all(state);
+                if (nullptr != par) {
+                    if (0 == next_parties) {
+                        par->arrive_and_deregister();
+                    } else {
+                        par->arrive();
+                    }
+                }
+            }
+            return ph;
+        }
+    }
+
+    void sync_with_parent(uint64_t st) {
+        uint32_t ph = state_phase(st);
+        uint32_t next = parent->await_phase(ph);
+        uint32_t parties = state_parties(st);
+        uint64_t updated = make_state(next, parties, parties);
+        if (state.compare_exchange_strong(st, updated, std::memory_order_acq_rel)) {
+            atomic_notify_all(state);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_PHASER_HPP */
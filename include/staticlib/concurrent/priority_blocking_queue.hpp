@@ -0,0 +1,410 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   priority_blocking_queue.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:45 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_PRIORITY_BLOCKING_QUEUE_HPP
+#define STATICLIB_CONCURRENT_PRIORITY_BLOCKING_QUEUE_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+// VS2013 does not support 'thread_local', its '__declspec(thread)' is enough for POD values
+#ifndef STATICLIB_CONCURRENT_THREAD_LOCAL
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define STATICLIB_CONCURRENT_THREAD_LOCAL __declspec(thread)
+#else
+#define STATICLIB_CONCURRENT_THREAD_LOCAL thread_local
+#endif
+#endif // STATICLIB_CONCURRENT_THREAD_LOCAL
+
+// based on: "MultiQueues: Simple Relaxed Concurrent Priority Queues", Rihani, Sanders, Dementiev, SPAA 2015
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Optionally bounded concurrent priority queue with support for blocking and
+ * non-blocking multiple consumers and always non-blocking multiple producers.
+ * Elements are spread over multiple heaps, each guarded by its own mutex,
+ * consumers take the best of the tops of two randomly chosen heaps. Ordering
+ * is relaxed: the taken element is one of the most urgent elements, but not
+ * necessarily the most urgent one, unless the queue is created with a single heap.
+ * The same as with `std::priority_queue`, the `Compare` defines "less urgent than"
+ * relation, so the greatest element is taken first with default `std::less`.
+ */
+template<typename T, typename Compare = std::less<T>>
+class priority_blocking_queue : public std::enable_shared_from_this<priority_blocking_queue<T, Compare>> {
+    static const size_t poll_attempts = 4;
+
+    class heap {
+    public:
+        std::mutex mutex;
+        std::vector<T> records;
+        char padding[64];
+    };
+
+    const size_t max_queue_size;
+    const size_t heaps_count;
+    std::unique_ptr<heap[]> heaps;
+    Compare comp;
+    std::atomic<size_t> count;
+    eventcount empty_ec;
+    std::atomic<bool> unblocked;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param max_queue_size max number of elements, zero value
+     *        (supplied by default) means unbounded queue
+     * @param queues_count number of internal heaps, zero value (supplied
+     *        by default) means twice the hardware concurrency
+     * @param comp comparator
+     */
+    explicit priority_blocking_queue(size_t max_queue_size = 0, size_t queues_count = 0,
+            Compare comp = Compare()) :
+    max_queue_size(max_queue_size),
+    heaps_count(queues_count > 0 ? queues_count : std::max(std::thread::hardware_concurrency() * 2, 2u)),
+    heaps(new heap[heaps_count]),
+    comp(std::move(comp)),
+    count(0),
+    unblocked(false) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    priority_blocking_queue(const priority_blocking_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    priority_blocking_queue& operator=(const priority_blocking_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    priority_blocking_queue(priority_blocking_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    priority_blocking_queue& operator=(priority_blocking_queue&&) = delete;
+
+    /**
+     * Emplace a value into the queue
+     *
+     * @param record_args constructor arguments for queue element
+     * @return false if the queue was full, true otherwise
+     */
+    template<typename ...Args>
+    bool emplace(Args&&... record_args) {
+        if (!reserve()) {
+            return false;
+        }
+        uint64_t rnd = next_random();
+        size_t idx = static_cast<size_t> (rnd % heaps_count);
+        // prefer uncontended heap
+        for (size_t i = 0; i < heaps_count; i++) {
+            heap& hp = heaps[(idx + i) % heaps_count];
+            std::unique_lock<std::mutex> guard{hp.mutex, std::try_to_lock};
+            if (guard.owns_lock()) {
+                push(hp, std::forward<Args>(record_args)...);
+                guard.unlock();
+                empty_ec.notify_one();
+                return true;
+            }
+        }
+        {
+            heap& hp = heaps[idx];
+            std::lock_guard<std::mutex> guard{hp.mutex};
+            push(hp, std::forward<Args>(record_args)...);
+        }
+        empty_ec.notify_one();
+        return true;
+    }
+
+    /**
+     * Attempt to read the most urgent value (approximately) into a variable.
+     * This method returns immediately.
+     *
+     * @param record move (or copy) the value from the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(T& record) {
+        if (0 == count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (heaps_count > 1) {
+            for (size_t i = 0; i < poll_attempts; i++) {
+                if (poll_two_choices(record)) {
+                    return true;
+                }
+            }
+        }
+        // contended or most of the heaps are empty
+        return poll_scan(record);
+    }
+
+    /**
+     * Attempt to read the most urgent value (approximately) into a variable.
+     * This method will wait on empty queue infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move (or copy) the value from the queue to given variable
+     * @param timeout max amount of milliseconds to wait on empty queue,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if queue was empty after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (poll(record)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            auto key = empty_ec.prepare_wait();
+            if (poll(record)) {
+                empty_ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                empty_ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                empty_ec.wait(key);
+            } else if (!empty_ec.wait_until(key, deadline)) {
+                return poll(record);
+            }
+        }
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        unblocked.store(true, std::memory_order_release);
+        empty_ec.notify_all();
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if the queue is empty, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        return 0 == size();
+    }
+
+    /**
+     * Check if the queue is full, always false for unbounded queue
+     *
+     * @return whether queue is full
+     */
+    bool full() const {
+        if (0 == max_queue_size) {
+            return false;
+        }
+        return size() >= max_queue_size;
+    }
+
+    /**
+     * Returns the number of entries in the queue, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        return count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Accessor for max queue size specified at creation
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return max_queue_size;
+    }
+
+private:
+    bool reserve() {
+        if (0 == max_queue_size) {
+            count.fetch_add(1, std::memory_order_acq_rel);
+            return true;
+        }
+        size_t cur = count.load(std::memory_order_relaxed);
+        do {
+            if (cur >= max_queue_size) {
+                return false;
+            }
+        } while (!count.compare_exchange_weak(cur, cur + 1, std::memory_order_acq_rel));
+        return true;
+    }
+
+    template<typename ...Args>
+    void push(heap& hp, Args&&... record_args) {
+        try {
+            hp.records.emplace_back(std::forward<Args>(record_args)...);
+        } catch (...) {
+            count.fetch_sub(1, std::memory_order_acq_rel);
+            throw;
+        }
+        std::push_heap(hp.records.begin(), hp.records.end(), comp);
+    }
+
+    void pop(heap& hp, T& record) {
+        std::pop_heap(hp.records.begin(), hp.records.end(), comp);
+        record = std::move(hp.records.back());
+        hp.records.pop_back();
+        count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    bool poll_two_choices(T& record) {
+        size_t first = 0;
+        size_t second = 0;
+        choose_two(first, second);
+        std::unique_lock<std::mutex> guard1{heaps[first].mutex, std::try_to_lock};
+        std::unique_lock<std::mutex> guard2{heaps[second].mutex, std::try_to_lock};
+        return pop_better(guard1.owns_lock() ? heaps.get() + first : nullptr,
+                guard2.owns_lock() ? heaps.get() + second : nullptr, record);
+    }
+
+    // called when try-locking keeps failing, heaps are locked in the index order,
+    // linear scan is used only when both chosen heaps are empty
+    bool poll_scan(T& record) {
+        if (heaps_count > 1) {
+            size_t first = 0;
+            size_t second = 0;
+            choose_two(first, second);
+            if (first > second) {
+                std::swap(first, second);
+            }
+            std::lock_guard<std::mutex> guard1{heaps[first].mutex};
+            std::lock_guard<std::mutex> guard2{heaps[second].mutex};
+            if (pop_better(heaps.get() + first, heaps.get() + second, record)) {
+                return true;
+            }
+        }
+        size_t start = static_cast<size_t> (next_random() % heaps_count);
+        for (size_t i = 0; i < heaps_count; i++) {
+            if (0 == count.load(std::memory_order_acquire)) {
+                return false;
+            }
+            heap& hp = heaps[(start + i) % heaps_count];
+            std::lock_guard<std::mutex> guard{hp.mutex};
+            if (!hp.records.empty()) {
+                pop(hp, record);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void choose_two(size_t& first, size_t& second) {
+        uint64_t rnd = next_random();
+        first = static_cast<size_t> (rnd % heaps_count);
+        second = static_cast<size_t> ((rnd >> 32) % (heaps_count - 1));
+        if (second >= first) {
+            second += 1;
+        }
+    }
+
+    // heaps are passed locked, null heap is skipped
+    bool pop_better(heap* hp1, heap* hp2, T& record) {
+        bool ok1 = nullptr != hp1 && !hp1->records.empty();
+        bool ok2 = nullptr != hp2 && !hp2->records.empty();
+        if (ok1 && ok2) {
+            if (comp(hp1->records.front(), hp2->records.front())) {
+                ok1 = false;
+            } else {
+                ok2 = false;
+            }
+        }
+        if (ok1) {
+            pop(*hp1, record);
+            return true;
+        }
+        if (ok2) {
+            pop(*hp2, record);
+            return true;
+        }
+        return false;
+    }
+
+    // per-thread xorshift64*, seeded on the first call
+    // from the thread id hash, stack address and clock ticks
+    static uint64_t next_random() {
+        static STATICLIB_CONCURRENT_THREAD_LOCAL uint64_t state = 0;
+        if (0 == state) {
+            char local = 0;
+            uint64_t x = static_cast<uint64_t> (std::hash<std::thread::id>()(std::this_thread::get_id()));
+            x ^= static_cast<uint64_t> (reinterpret_cast<uintptr_t> (std::addressof(local)));
+            x += static_cast<uint64_t> (std::chrono::steady_clock::now().time_since_epoch().count()) *
+                    0x9E3779B97F4A7C15ULL;
+            // splitmix64 finalizer
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            state = 0 != x ? x : 0x9E3779B97F4A7C15ULL;
+        }
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+};
+
+template<typename T, typename Compare>
+const size_t priority_blocking_queue<T, Compare>::poll_attempts;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_PRIORITY_BLOCKING_QUEUE_HPP */
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   rcu_cell.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:20 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_RCU_CELL_HPP
+#define STATICLIB_CONCURRENT_RCU_CELL_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// based on: "Sleepable Read-Copy Update" by Paul E. McKenney
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Holder of the immutable object for read-mostly data (configs, routing tables)
+ * with read-copy-update semantics. Readers take a `snapshot` that pins
+ * the current version, entering and leaving the read section touches only
+ * the reader counter of calling thread's shard. Writers replace the object
+ * with a new version, replaced versions are deleted after the grace period,
+ * when all the readers that could see them have left. Versions are reclaimed
+ * in batches of the specified size, `reclaim` can be also called periodically
+ * from a background thread. Writers must not be called inside the read section.
+ */
+template<typename T>
+class rcu_cell : public std::enable_shared_from_this<rcu_cell<T>> {
+    static const size_t spins_count = 128;
+
+    class shard {
+    public:
+        // readers entered with even and odd epoch
+        std::atomic<size_t> readers[2];
+        char padding[64];
+
+        shard() {
+            readers[0].store(0, std::memory_order_relaxed);
+            readers[1].store(0, std::memory_order_relaxed);
+        }
+    };
+
+    const size_t shards_mask;
+    const size_t reclaim_batch;
+    std::unique_ptr<shard[]> shards;
+    std::atomic<T*> current;
+    std::atomic<uint32_t> epoch;
+    std::mutex writer_mutex;
+    std::vector<T*> retired;
+
+public:
+    /**
+     * Read-side guard that keeps the pinned version alive,
+     * must be destroyed in the same thread it was obtained in
+     */
+    class snapshot {
+        friend class rcu_cell;
+
+        shard* sh;
+        size_t idx;
+        const T* ptr;
+
+        snapshot(shard* sh, size_t idx, const T* ptr) :
+        sh(sh),
+        idx(idx),
+        ptr(ptr) { }
+
+    public:
+        /**
+         * Destructor, leaves the read section
+         */
+        ~snapshot() {
+            if (nullptr != sh) {
+                sh->readers[idx].fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        /**
+         * Deleted copy constructor
+         */
+        snapshot(const snapshot&) = delete;
+
+        /**
+         * Deleted copy assignment operator
+         */
+        snapshot& operator=(const snapshot&) = delete;
+
+        /**
+         * Move constructor
+         *
+         * @param other other instance
+         */
+        snapshot(snapshot&& other) :
+        sh(other.sh),
+        idx(other.idx),
+        ptr(other.ptr) {
+            other.sh = nullptr;
+            other.ptr = nullptr;
+        }
+
+        /**
+         * Deleted move assignment operator
+         */
+        snapshot& operator=(snapshot&&) = delete;
+
+        /**
+         * Accessor for the pinned version
+         *
+         * @return pointer to the pinned version, may be null
+         */
+        const T* get() const {
+            return ptr;
+        }
+
+        /**
+         * Member access operator
+         *
+         * @return pointer to the pinned version
+         */
+        const T* operator->() const {
+            return ptr;
+        }
+
+        /**
+         * Dereference operator
+         *
+         * @return reference to the pinned version
+         */
+        const T& operator*() const {
+            return *ptr;
+        }
+
+        /**
+         * Checks whether the pinned version is not null
+         *
+         * @return true if version is not null, false otherwise
+         */
+        explicit operator bool() const {
+            return nullptr != ptr;
+        }
+    };
+
+    /**
+     * Constructor
+     *
+     * @param initial initial version, may be empty
+     * @param reclaim_batch number of replaced versions to accumulate
+     *        before waiting for the grace period, 1 by default
+     * @param shards_count number of reader shards, rounded up to the power of 2,
+     *        zero value (supplied by default) means twice the hardware concurrency
+     */
+    explicit rcu_cell(std::unique_ptr<T> initial = std::unique_ptr<T>(), size_t reclaim_batch = 1,
+            size_t shards_count = 0) :
+    shards_mask(round_up(shards_count > 0 ? shards_count : std::thread::hardware_concurrency() * 2) - 1),
+    reclaim_batch(reclaim_batch > 0 ? reclaim_batch : 1),
+    shards(new shard[shards_mask + 1]),
+    current(initial.release()),
+    epoch(0) { }
+
+    /**
+     * Destructor, deletes current and all replaced versions,
+     * there must be no readers at this point
+     */
+    ~rcu_cell() {
+        for (T* ptr : retired) {
+            delete ptr;
+        }
+        delete current.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    rcu_cell(const rcu_cell&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    rcu_cell& operator=(const rcu_cell&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    rcu_cell(rcu_cell&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    rcu_cell& operator=(rcu_cell&&) = delete;
+
+    /**
+     * Enters the read section and pins the current version,
+     * version stays alive until the returned snapshot is destroyed
+     *
+     * @return snapshot of the current version
+     */
+    snapshot read() {
+        shard& sh = current_shard();
+        size_t idx = epoch.load(std::memory_order_relaxed) & 1;
+        // paired with the pointer exchange and counters scan in writer
+        sh.readers[idx].fetch_add(1, std::memory_order_seq_cst);
+        const T* ptr = current.load(std::memory_order_seq_cst);
+        return snapshot(std::addressof(sh), idx, ptr);
+    }
+
+    /**
+     * Replaces the current version, replaced version is deleted
+     * after the grace period
+     *
+     * @param value new version, may be empty
+     */
+    void store(std::unique_ptr<T> value) {
+        std::lock_guard<std::mutex> guard{writer_mutex};
+        T* prev = current.exchange(value.release(), std::memory_order_seq_cst);
+        if (nullptr != prev) {
+            retired.push_back(prev);
+        }
+        if (retired.size() >= reclaim_batch) {
+            reclaim_locked();
+        }
+    }
+
+    /**
+     * Creates a new version from the current one using specified
+     * functor and replaces the current version with it
+     *
+     * @param func functor that accepts pointer to the current version (may be null)
+     *        and returns `std::unique_ptr` to the new version
+     */
+    template<typename Func>
+    void update(Func func) {
+        std::lock_guard<std::mutex> guard{writer_mutex};
+        std::unique_ptr<T> value = func(static_cast<const T*> (current.load(std::memory_order_acquire)));
+        T* prev = current.exchange(value.release(), std::memory_order_seq_cst);
+        if (nullptr != prev) {
+            retired.push_back(prev);
+        }
+        if (retired.size() >= reclaim_batch) {
+            reclaim_locked();
+        }
+    }
+
+    /**
+     * Waits for the grace period and deletes all the replaced versions,
+     * can be called periodically from a background thread
+     *
+     * @return number of deleted versions
+     */
+    size_t reclaim() {
+        std::lock_guard<std::mutex> guard{writer_mutex};
+        return reclaim_locked();
+    }
+
+    /**
+     * Returns the number of replaced versions waiting for the grace period
+     *
+     * @return number of replaced versions
+     */
+    size_t retired_count() {
+        std::lock_guard<std::mutex> guard{writer_mutex};
+        return retired.size();
+    }
+
+private:
+    static size_t round_up(size_t size) {
+        size_t res = 1;
+        while (res < size) {
+            res <<= 1;
+        }
+        return res;
+    }
+
+    shard& current_shard() {
+        size_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        return shards[(hash ^ (hash >> 16)) & shards_mask];
+    }
+
+    size_t reclaim_locked() {
+        if (retired.empty()) {
+            return 0;
+        }
+        synchronize();
+        size_t res = retired.size();
+        for (T* ptr : retired) {
+            delete ptr;
+        }
+        retired.clear();
+        return res;
+    }
+
+    void synchronize() {
+        uint32_t ep = epoch.load(std::memory_order_relaxed);
+        size_t idx = ep & 1;
+        // readers that loaded the previous epoch just before the last flip
+        await_readers(idx ^ 1);
+        epoch.store(ep + 1, std::memory_order_seq_cst);
+        // new readers use other counter, so this one drains
+        await_readers(idx);
+    }
+
+    void await_readers(size_t idx) {
+        for (size_t i = 0; i <= shards_mask; i++) {
+            std::atomic<size_t>& readers = shards[i].readers[idx];
+            for (size_t j = 0; 0 != readers.load(std::memory_order_seq_cst); j++) {
+                if (j < spins_count) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+    }
+
+};
+
+template<typename T>
+const size_t rcu_cell<T>::spins_count;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_RCU_CELL_HPP */
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   readiness_notifier.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 8:00 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_READINESS_NOTIFIER_HPP
+#define STATICLIB_CONCURRENT_READINESS_NOTIFIER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Default notifier policy of the waiting queues, does nothing
+ * and is optimized out completely
+ */
+class null_notifier {
+public:
+    /**
+     * Called by the queue when elements become available or when
+     * it is unblocked, no-op
+     */
+    void notify() { }
+};
+
+#ifdef __linux__
+
+/**
+ * Notifier policy of the waiting queues (`Notifier` template parameter of
+ * `mpmc_blocking_queue` and waiting SPSC queues), that signals a non-blocking
+ * `eventfd` when the queue goes from empty to non-empty, so the queue can be
+ * waited on in `epoll`/`poll` loop together with sockets. Writes are coalesced:
+ * notifier is disarmed by the first write and `notify` is a fence and a single atomic load
+ * until the consumer arms it again. Consumer protocol: on fd readiness call `reset`,
+ * drain the queue with `poll` until it is empty, call `arm` and check the queue
+ * once more, elements emplaced before `arm` do not signal the fd.
+ * Notifier is created armed. Available only on Linux.
+ */
+class eventfd_notifier {
+    int efd;
+    std::atomic<bool> armed;
+
+public:
+    /**
+     * Constructor, creates non-blocking eventfd
+     *
+     * @throws std::system_error if eventfd cannot be created
+     */
+    eventfd_notifier() :
+    efd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    armed(true) {
+        if (-1 == efd) {
+            throw std::system_error(errno, std::system_category(), "eventfd");
+        }
+    }
+
+    /**
+     * Destructor, closes eventfd
+     */
+    ~eventfd_notifier() {
+        ::close(efd);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    eventfd_notifier(const eventfd_notifier&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    eventfd_notifier& operator=(const eventfd_notifier&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    eventfd_notifier(eventfd_notifier&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    eventfd_notifier& operator=(eventfd_notifier&&) = delete;
+
+    /**
+     * File descriptor to register for `EPOLLIN` in the event loop,
+     * owned by this notifier
+     *
+     * @return eventfd file descriptor
+     */
+    int fd() const {
+        return efd;
+    }
+
+    /**
+     * Arms the notifier, next `notify` call will signal the fd;
+     * queue must be checked for elements after this call
+     */
+    void arm() {
+        armed.store(true, std::memory_order_relaxed);
+        // pairs with the fence in notify, either consumer sees the element
+        // or producer sees the armed flag
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * Checks whether the notifier is armed
+     *
+     * @return whether the notifier is armed
+     */
+    bool is_armed() const {
+        return armed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Signals the fd if the notifier is armed and disarms it,
+     * called by the queue after the element is published
+     */
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (armed.load(std::memory_order_relaxed) && armed.exchange(false, std::memory_order_acq_rel)) {
+            uint64_t one = 1;
+            // can only fail with EAGAIN on counter overflow, fd is readable then anyway
+            ssize_t written = ::write(efd, std::addressof(one), sizeof (one));
+            (void) written;
+        }
+    }
+
+    /**
+     * Resets the fd readiness, must be called by the consumer
+     * before draining the queue
+     *
+     * @return false if the fd was not signalled, true otherwise
+     */
+    bool reset() {
+        uint64_t count = 0;
+        return static_cast<ssize_t> (sizeof (count)) == ::read(efd, std::addressof(count), sizeof (count));
+    }
+
+};
+
+#endif // __linux__
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_READINESS_NOTIFIER_HPP */
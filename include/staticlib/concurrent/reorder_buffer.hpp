@@ -0,0 +1,308 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   reorder_buffer.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 6:00 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_REORDER_BUFFER_HPP
+#define STATICLIB_CONCURRENT_REORDER_BUFFER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Bounded buffer that restores the sequence order of the items completed
+ * out of order by multiple workers. Producers put items tagged with unique
+ * sequence numbers, single consumer receives them strictly in sequence.
+ * Item with the sequence number that is `window_size` or more ahead of the
+ * next expected one blocks its producer, so slow head item gives backpressure
+ * to the workers. Slots are preallocated, `put` and `poll` are lock-free,
+ * threads are parked on eventcounts only when they need to wait.
+ */
+template<typename T>
+class reorder_buffer : public std::enable_shared_from_this<reorder_buffer<T>> {
+
+    class slot {
+    public:
+        typename std::aligned_storage<sizeof (T), std::alignment_of<T>::value>::type storage;
+        // sequence number + 1 when filled, zero when empty
+        std::atomic<uint64_t> ready;
+        char padding[64];
+
+        slot() :
+        ready(0) { }
+
+        T* value() {
+            return reinterpret_cast<T*> (std::addressof(storage));
+        }
+    };
+
+    const uint64_t window;
+    std::unique_ptr<slot[]> slots;
+    char padding1[64];
+    // next expected sequence number, written only by consumer
+    std::atomic<uint64_t> head;
+    char padding2[64 - sizeof (std::atomic<uint64_t>)];
+    eventcount ready_ec;
+    eventcount window_ec;
+    std::atomic<bool> unblocked;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param window_size max distance between the sequence number of the put item
+     *        and the next expected one, must be >= 1
+     * @param first_sequence sequence number of the first item
+     */
+    explicit reorder_buffer(size_t window_size, uint64_t first_sequence = 0) :
+    window(window_size > 0 ? window_size : 1),
+    slots(new slot[window_size > 0 ? window_size : 1]),
+    head(first_sequence),
+    unblocked(false) { }
+
+    /**
+     * Destructor, destroys the items that were not consumed
+     */
+    ~reorder_buffer() {
+        for (uint64_t i = 0; i < window; i++) {
+            if (0 != slots[i].ready.load(std::memory_order_acquire)) {
+                slots[i].value()->~T();
+            }
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    reorder_buffer(const reorder_buffer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    reorder_buffer& operator=(const reorder_buffer&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    reorder_buffer(reorder_buffer&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    reorder_buffer& operator=(reorder_buffer&&) = delete;
+
+    /**
+     * Puts the item with the specified sequence number, waits while
+     * it is too far ahead of the next expected one (by default infinitely,
+     * or up to specified amount of milliseconds)
+     *
+     * @param sequence unique sequence number of the item
+     * @param record item to put
+     * @param timeout max amount of milliseconds to wait for the window,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return false if the sequence number was already consumed, the buffer
+     *         was unblocked or timeout expired, true otherwise
+     */
+    bool put(uint64_t sequence, T record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (!await_window(sequence, timeout)) {
+            return false;
+        }
+        slot& sl = slots[sequence % window];
+        ::new (sl.value()) T(std::move(record));
+        sl.ready.store(sequence + 1, std::memory_order_release);
+        ready_ec.notify_all();
+        return true;
+    }
+
+    /**
+     * Attempt to read the next item in sequence into a variable.
+     * This method returns immediately.
+     *
+     * @param record move the next item to given variable
+     * @return returns false if next item was not put yet, true otherwise
+     */
+    bool poll(T& record) {
+        uint64_t seq = head.load(std::memory_order_relaxed);
+        slot& sl = slots[seq % window];
+        if (seq + 1 != sl.ready.load(std::memory_order_acquire)) {
+            return false;
+        }
+        T* ptr = sl.value();
+        record = std::move(*ptr);
+        ptr->~T();
+        sl.ready.store(0, std::memory_order_relaxed);
+        head.store(seq + 1, std::memory_order_release);
+        window_ec.notify_all();
+        return true;
+    }
+
+    /**
+     * Consume all the items, that are immediately available
+     * in sequence, into specified functor
+     *
+     * @param func functor to consume items
+     * @return number of items consumed
+     */
+    template<typename Func>
+    size_t poll(Func&& func) {
+        size_t res = 0;
+        uint64_t seq = head.load(std::memory_order_relaxed);
+        for (;;) {
+            slot& sl = slots[seq % window];
+            if (seq + 1 != sl.ready.load(std::memory_order_acquire)) {
+                break;
+            }
+            T* ptr = sl.value();
+            T record = std::move(*ptr);
+            ptr->~T();
+            sl.ready.store(0, std::memory_order_relaxed);
+            seq += 1;
+            head.store(seq, std::memory_order_release);
+            window_ec.notify_all();
+            res += 1;
+            func(std::move(record));
+        }
+        return res;
+    }
+
+    /**
+     * Attempt to read the next item in sequence into a variable.
+     * This method will wait for it infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move the next item to given variable
+     * @param timeout max amount of milliseconds to wait for the next item,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if next item was not put after timeout, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (poll(record)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            auto key = ready_ec.prepare_wait();
+            if (poll(record)) {
+                ready_ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                ready_ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                ready_ec.wait(key);
+            } else if (!ready_ec.wait_until(key, deadline)) {
+                return poll(record);
+            }
+        }
+    }
+
+    /**
+     * Unblocks the buffer allowing consumer to exit 'take'
+     * and producers to exit 'put' calls. Buffer cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        unblocked.store(true, std::memory_order_release);
+        ready_ec.notify_all();
+        window_ec.notify_all();
+    }
+
+    /**
+     * Checks whether this buffer was unblocked
+     *
+     * @return whether this buffer was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the sequence number of the next item to be consumed
+     *
+     * @return next expected sequence number
+     */
+    uint64_t next_sequence() const {
+        return head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Accessor for window size specified at creation
+     *
+     * @return window size
+     */
+    size_t window_size() const {
+        return static_cast<size_t> (window);
+    }
+
+private:
+    bool in_window(uint64_t sequence) const {
+        return sequence < head.load(std::memory_order_acquire) + window;
+    }
+
+    bool await_window(uint64_t sequence, std::chrono::milliseconds timeout) {
+        if (sequence < head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (in_window(sequence)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            auto key = window_ec.prepare_wait();
+            if (in_window(sequence)) {
+                window_ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                window_ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                window_ec.wait(key);
+            } else if (!window_ec.wait_until(key, deadline)) {
+                return in_window(sequence);
+            }
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_REORDER_BUFFER_HPP */
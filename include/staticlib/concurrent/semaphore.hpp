@@ -0,0 +1,313 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   semaphore.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:50 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_SEMAPHORE_HPP
+#define STATICLIB_CONCURRENT_SEMAPHORE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+#include "staticlib/concurrent/eventcount.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Counting semaphore, `acquire` and `release` are single atomic operations
+ * when there is no contention. In default (non-fair) mode blocked threads
+ * are parked on the `eventcount` and may be overtaken by the newly arrived ones.
+ * In fair mode permits are granted to the blocked threads in FIFO order,
+ * new threads do not overtake the blocked ones.
+ */
+class semaphore : public std::enable_shared_from_this<semaphore> {
+
+    class waiter_node {
+    public:
+        const size_t permits;
+        std::atomic<uint32_t> granted;
+        waiter_node* prev = nullptr;
+        waiter_node* next = nullptr;
+
+        explicit waiter_node(size_t permits) :
+        permits(permits),
+        granted(0) { }
+    };
+
+    const bool fair;
+    std::atomic<int64_t> count;
+    // non-fair mode
+    eventcount ec;
+    std::atomic<uint32_t> bulk_waiters;
+    // fair mode
+    std::mutex mutex;
+    std::atomic<uint32_t> queued;
+    waiter_node* head = nullptr;
+    waiter_node* tail = nullptr;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param permits initial number of available permits
+     * @param fair whether to grant permits to the blocked threads in FIFO order,
+     *        false by default
+     */
+    explicit semaphore(size_t permits = 0, bool fair = false) :
+    fair(fair),
+    count(static_cast<int64_t> (permits)),
+    bulk_waiters(0),
+    queued(0) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    semaphore(const semaphore&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    semaphore& operator=(const semaphore&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    semaphore(semaphore&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    semaphore& operator=(semaphore&&) = delete;
+
+    /**
+     * Acquires specified number of permits, blocks until
+     * they will become available
+     *
+     * @param permits number of permits to acquire
+     */
+    void acquire(size_t permits = 1) {
+        if (!try_acquire(permits)) {
+            acquire_slow(permits, false, std::chrono::steady_clock::time_point());
+        }
+    }
+
+    /**
+     * Acquires specified number of permits only if they are
+     * available at the time of the call, in fair mode permits
+     * are not acquired if there are blocked threads
+     *
+     * @param permits number of permits to acquire
+     * @return true if permits were acquired, false otherwise
+     */
+    bool try_acquire(size_t permits = 1) {
+        if (fair && queued.load(std::memory_order_acquire) > 0) {
+            return false;
+        }
+        return take(permits);
+    }
+
+    /**
+     * Acquires specified number of permits, blocks until
+     * they will become available or until specified timeout will be expired
+     *
+     * @param timeout max time period to wait
+     * @param permits number of permits to acquire
+     * @return false if exit on timeout expiry, true otherwise
+     */
+    bool try_acquire_for(std::chrono::milliseconds timeout, size_t permits = 1) {
+        return try_acquire_until(std::chrono::steady_clock::now() + timeout, permits);
+    }
+
+    /**
+     * Acquires specified number of permits, blocks until
+     * they will become available or until the deadline is reached
+     *
+     * @param deadline time point to wait until
+     * @param permits number of permits to acquire
+     * @return false if exit on deadline, true otherwise
+     */
+    bool try_acquire_until(const std::chrono::steady_clock::time_point& deadline, size_t permits = 1) {
+        if (try_acquire(permits)) {
+            return true;
+        }
+        return acquire_slow(permits, true, deadline);
+    }
+
+    /**
+     * Releases specified number of permits
+     *
+     * @param permits number of permits to release
+     */
+    void release(size_t permits = 1) {
+        if (0 == permits) {
+            return;
+        }
+        count.fetch_add(static_cast<int64_t> (permits), std::memory_order_acq_rel);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (fair) {
+            if (queued.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> guard{mutex};
+                grant_locked();
+            }
+        } else if (permits > 1 || bulk_waiters.load(std::memory_order_relaxed) > 0) {
+            // one woken thread may be unable to proceed with bulk acquire
+            ec.notify_all();
+        } else {
+            ec.notify_one();
+        }
+    }
+
+    /**
+     * Returns the number of currently available permits
+     *
+     * @return number of available permits
+     */
+    size_t available_permits() const {
+        int64_t res = count.load(std::memory_order_acquire);
+        return res > 0 ? static_cast<size_t> (res) : 0;
+    }
+
+    /**
+     * Returns whether this semaphore grants permits in FIFO order
+     *
+     * @return true if semaphore is fair, false otherwise
+     */
+    bool is_fair() const {
+        return fair;
+    }
+
+private:
+    bool take(size_t permits) {
+        int64_t needed = static_cast<int64_t> (permits);
+        int64_t cur = count.load(std::memory_order_relaxed);
+        while (cur >= needed) {
+            if (count.compare_exchange_weak(cur, cur - needed, std::memory_order_acquire,
+                    std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool acquire_slow(size_t permits, bool timed, const std::chrono::steady_clock::time_point& deadline) {
+        if (fair) {
+            return acquire_fair(permits, timed, deadline);
+        }
+        bool bulk = permits > 1;
+        if (bulk) {
+            // paired with the fence in 'release'
+            bulk_waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        auto pred = [this, permits] {
+            return take(permits);
+        };
+        bool res = true;
+        if (timed) {
+            res = ec.await_until(pred, deadline);
+        } else {
+            ec.await(pred);
+        }
+        if (bulk) {
+            bulk_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return res;
+    }
+
+    bool acquire_fair(size_t permits, bool timed, const std::chrono::steady_clock::time_point& deadline) {
+        waiter_node node{permits};
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            enqueue(node);
+            // paired with the fence in 'release'
+            queued.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            grant_locked();
+        }
+        if (!timed) {
+            atomic_wait(node.granted, 0u);
+            return true;
+        }
+        if (atomic_wait_until(node.granted, 0u, deadline)) {
+            return true;
+        }
+        std::lock_guard<std::mutex> guard{mutex};
+        if (0 != node.granted.load(std::memory_order_acquire)) {
+            return true;
+        }
+        unlink(node);
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        // removed head may have blocked the next waiters
+        grant_locked();
+        return false;
+    }
+
+    void grant_locked() {
+        while (nullptr != head) {
+            waiter_node* nd = head;
+            if (!take(nd->permits)) {
+                break;
+            }
+            unlink(*nd);
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            std::atomic<uint32_t>& granted = nd->granted;
+            granted.store(1, std::memory_order_release);
+            // node may be already destroyed, only its address is used
+            atomic_notify_one(granted);
+        }
+    }
+
+    void enqueue(waiter_node& node) {
+        node.prev = tail;
+        if (nullptr != tail) {
+            tail->next = std::addressof(node);
+        } else {
+            head = std::addressof(node);
+        }
+        tail = std::addressof(node);
+    }
+
+    void unlink(waiter_node& node) {
+        if (nullptr != node.prev) {
+            node.prev->next = node.next;
+        } else {
+            head = node.next;
+        }
+        if (nullptr != node.next) {
+            node.next->prev = node.prev;
+        } else {
+            tail = node.prev;
+        }
+        node.prev = nullptr;
+        node.next = nullptr;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_SEMAPHORE_HPP */
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   seqlock_cell.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:45 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_SEQLOCK_CELL_HPP
+#define STATICLIB_CONCURRENT_SEQLOCK_CELL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// based on: "Can Seqlocks Get Along with Programming Language Memory Models?" by Hans-J. Boehm
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Single-writer cell that holds the latest value of trivially copyable type,
+ * for "last value wins" data published to multiple readers. Writer never
+ * waits, readers copy the value optimistically and retry if it was
+ * changed during the copy. Value is stored as an array of relaxed atomic
+ * words, so concurrent copying is race-free. With multiple `Slots`
+ * writer writes the values into slots in round-robin order, so a slow
+ * reader has to be overtaken `Slots` times before it needs to retry.
+ */
+template<typename T, size_t Slots = 1>
+class seqlock_cell : public std::enable_shared_from_this<seqlock_cell<T, Slots>> {
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+    static_assert(__has_trivial_copy(T), "Value type must be trivially copyable");
+#else
+    static_assert(std::is_trivially_copyable<T>::value, "Value type must be trivially copyable");
+#endif // old GCC
+    static_assert(Slots > 0, "At least one slot is required");
+
+    static const size_t words_count = (sizeof (T) + sizeof (size_t) - 1) / sizeof (size_t);
+    static const size_t spins_count = 64;
+
+    class slot {
+    public:
+        // 2 * version + 1 while writing, 2 * version + 2 after
+        std::atomic<size_t> seq;
+        std::atomic<size_t> words[words_count];
+        char padding[64];
+
+        slot() :
+        seq(0) { }
+    };
+
+    slot slots[Slots];
+    std::atomic<size_t> latest;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param value initial value
+     */
+    explicit seqlock_cell(const T& value = T()) :
+    latest(0) {
+        write_slot(slots[0], 0, value);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    seqlock_cell(const seqlock_cell&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    seqlock_cell& operator=(const seqlock_cell&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    seqlock_cell(seqlock_cell&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    seqlock_cell& operator=(seqlock_cell&&) = delete;
+
+    /**
+     * Publishes a new value, must be called only from a single
+     * writer thread, never waits for readers
+     *
+     * @param value value to publish
+     */
+    void store(const T& value) {
+        size_t ver = latest.load(std::memory_order_relaxed) + 1;
+        write_slot(slots[ver % Slots], ver, value);
+        latest.store(ver, std::memory_order_release);
+    }
+
+    /**
+     * Attempts to read the latest value, fails if the value
+     * was overwritten during the read
+     *
+     * @param value variable to read the value into
+     * @return true if the value was read, false otherwise
+     */
+    bool try_load(T& value) const {
+        size_t ver = latest.load(std::memory_order_acquire);
+        const slot& sl = slots[ver % Slots];
+        size_t seq = sl.seq.load(std::memory_order_acquire);
+        if (2 * ver + 2 != seq) {
+            return false;
+        }
+        size_t buf[words_count];
+        for (size_t i = 0; i < words_count; i++) {
+            buf[i] = sl.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq != sl.seq.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        std::memcpy(std::addressof(value), buf, sizeof (T));
+        return true;
+    }
+
+    /**
+     * Reads the latest value, retries until the consistent
+     * value will be read
+     *
+     * @return latest value
+     */
+    T load() const {
+        T res;
+        for (size_t i = 0; !try_load(res); i++) {
+            if (i >= spins_count) {
+                // writer may be preempted in the middle of the write
+                std::this_thread::yield();
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns the number of values published after creation,
+     * can be used by readers to detect changes cheaply
+     *
+     * @return version of the latest value
+     */
+    size_t version() const {
+        return latest.load(std::memory_order_acquire);
+    }
+
+private:
+    static void write_slot(slot& sl, size_t ver, const T& value) {
+        size_t buf[words_count];
+        buf[words_count - 1] = 0;
+        std::memcpy(buf, std::addressof(value), sizeof (T));
+        sl.seq.store(2 * ver + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < words_count; i++) {
+            sl.words[i].store(buf[i], std::memory_order_relaxed);
+        }
+        sl.seq.store(2 * ver + 2, std::memory_order_release);
+    }
+
+};
+
+template<typename T, size_t Slots>
+const size_t seqlock_cell<T, Slots>::words_count;
+
+template<typename T, size_t Slots>
+const size_t seqlock_cell<T, Slots>::spins_count;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_SEQLOCK_CELL_HPP */
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   spin_mutex.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:20 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_SPIN_MUTEX_HPP
+#define STATICLIB_CONCURRENT_SPIN_MUTEX_HPP
+
+#include <cstdint>
+#include <atomic>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+// based on: "Futexes Are Tricky" by Ulrich Drepper, mutex take 2
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Adaptive mutex for short critical sections, spins for a while
+ * when the mutex is locked and then blocks using `atomic_wait`.
+ * Unlocking does not make a syscall when there are no blocked threads.
+ * Satisfies `Lockable` requirements, can be used with `std::unique_lock`
+ * and `std::condition_variable_any` (`eventcount_condition` is cheaper).
+ */
+class spin_mutex {
+    // 0 - unlocked, 1 - locked, 2 - locked and may have blocked threads
+    static const size_t spins_count = 100;
+
+    std::atomic<uint32_t> state;
+
+public:
+    /**
+     * Constructor
+     */
+    spin_mutex() :
+    state(0) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    spin_mutex(const spin_mutex&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    spin_mutex& operator=(const spin_mutex&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    spin_mutex(spin_mutex&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    spin_mutex& operator=(spin_mutex&&) = delete;
+
+    /**
+     * Locks the mutex, blocks if the mutex is not available
+     */
+    void lock() {
+        uint32_t expected = 0;
+        if (state.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                std::memory_order_relaxed)) {
+            return;
+        }
+        for (size_t i = 0; i < spins_count; i++) {
+            if (0 == state.load(std::memory_order_relaxed)) {
+                expected = 0;
+                if (state.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+        // mutex is taken as contended, so unlock will wake the next thread
+        while (0 != state.exchange(2, std::memory_order_acquire)) {
+            atomic_wait(state, 2u);
+        }
+    }
+
+    /**
+     * Tries to lock the mutex, returns immediately
+     *
+     * @return true if the mutex was locked, false otherwise
+     */
+    bool try_lock() {
+        uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                std::memory_order_relaxed);
+    }
+
+    /**
+     * Unlocks the mutex
+     */
+    void unlock() {
+        if (2 == state.exchange(0, std::memory_order_release)) {
+            atomic_notify_one(state);
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_SPIN_MUTEX_HPP */
@@ -30,20 +30,31 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/readiness_notifier.hpp"
 #include "staticlib/concurrent/spsc_inobject_concurrent_queue.hpp"
 
 namespace staticlib {
 namespace concurrent {
 
 /**
- * Queue with the same logic as `spsc_waiting_queue` with additional optional blocking `take` operation
+ * Queue with the same logic as `spsc_waiting_queue` with additional optional blocking `take` operation,
+ * `Mutex` can be any `Lockable` type (`spin_mutex`, `ticket_mutex`, `mcs_mutex`),
+ * `eventcount_condition` is used for waiting with mutexes other than `std::mutex`,
+ * `Notifier` (`eventfd_notifier`) allows to wait for elements in `epoll` loop
  */
-template<typename T, size_t Size>
-class spsc_inobject_waiting_queue : public std::enable_shared_from_this<spsc_inobject_waiting_queue<T, Size>> {
-    mutable std::mutex mutex;
-    std::condition_variable empty_cv;
+template<typename T, size_t Size, typename Mutex = std::mutex, typename Notifier = null_notifier>
+class spsc_inobject_waiting_queue : public std::enable_shared_from_this<
+        spsc_inobject_waiting_queue<T, Size, Mutex, Notifier>> {
+    using cv_type = typename std::conditional<std::is_same<Mutex, std::mutex>::value,
+            std::condition_variable, eventcount_condition>::type;
+
+    mutable Mutex mutex;
+    cv_type empty_cv;
     spsc_inobject_concurrent_queue<T, Size> queue;
+    Notifier readiness;
     bool unblocked = false;
 
 public:
@@ -85,6 +96,9 @@ public:
     bool emplace(Args&&... record_args) {
         bool res = queue.emplace(std::forward<Args>(record_args)...);
         empty_cv.notify_one();
+        if (res) {
+            readiness.notify();
+        }
         return res;
     }
 
@@ -122,7 +136,7 @@ public:
         if (res) {
             return true;
         }
-        std::unique_lock<std::mutex> guard{mutex};
+        std::unique_lock<Mutex> guard{mutex};
         auto predicate = [this] {
             return this->unblocked || !this->queue.empty();
         };
@@ -140,11 +154,12 @@ public:
      * for waiting on it after this call.
      */
     void unblock() {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         this->unblocked = true;
         if (queue.empty()) {
             empty_cv.notify_one();
         }
+        readiness.notify();
     }
 
     /**
@@ -153,7 +168,7 @@ public:
      * @return whether this queue was unblocked
      */
     bool is_unblocked() const {
-        std::lock_guard<std::mutex> guard{mutex};
+        std::lock_guard<Mutex> guard{mutex};
         return unblocked;
     }
 
@@ -197,6 +212,16 @@ public:
     size_t max_size() const {
         return queue.max_size();
     }
+
+    /**
+     * Accessor for the readiness notifier, that is signalled
+     * when elements become available or when the queue is unblocked
+     *
+     * @return readiness notifier
+     */
+    Notifier& notifier() {
+        return readiness;
+    }
 };
 
 } // namespace
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   synchronous_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 7:00 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_SYNCHRONOUS_QUEUE_HPP
+#define STATICLIB_CONCURRENT_SYNCHRONOUS_QUEUE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+#include "staticlib/concurrent/spin_mutex.hpp"
+
+// based on: "Scalable Synchronous Queues" by William N. Scherer III, Doug Lea, Michael L. Scott
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Zero-capacity rendezvous queue: producer waits until a consumer takes
+ * its element and consumer waits until a producer hands an element over.
+ * Blocked threads are kept in a FIFO "dual queue" of their own stack nodes,
+ * where all the nodes are either producers or consumers. Arriving counterpart
+ * moves the element directly between the threads and wakes the matched one,
+ * woken threads spin shortly before parking. Queue list is guarded by
+ * a `spin_mutex`, critical sections are a few pointer updates long.
+ */
+template<typename T>
+class synchronous_queue : public std::enable_shared_from_this<synchronous_queue<T>> {
+    static const uint32_t waiting = 0;
+    static const uint32_t matched = 1;
+    static const uint32_t cancelled = 2;
+    static const size_t spins_count = 128;
+
+    class waiter_node {
+    public:
+        // destination for consumer, source for producer
+        T* elem;
+        const bool producer;
+        std::atomic<uint32_t> state;
+        waiter_node* prev = nullptr;
+        waiter_node* next = nullptr;
+
+        waiter_node(T* elem, bool producer) :
+        elem(elem),
+        producer(producer),
+        state(waiting) { }
+    };
+
+    spin_mutex mutex;
+    waiter_node* head = nullptr;
+    waiter_node* tail = nullptr;
+    std::atomic<size_t> producers_count;
+    std::atomic<size_t> consumers_count;
+    std::atomic<bool> unblocked;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     */
+    synchronous_queue() :
+    producers_count(0),
+    consumers_count(0),
+    unblocked(false) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    synchronous_queue(const synchronous_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    synchronous_queue& operator=(const synchronous_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    synchronous_queue(synchronous_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    synchronous_queue& operator=(synchronous_queue&&) = delete;
+
+    /**
+     * Hands the element over to a consumer, waits for it infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record element to hand over
+     * @param timeout max amount of milliseconds to wait for the consumer,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return false if the queue was unblocked or timeout expired, true otherwise
+     */
+    bool put(T record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        return transfer(std::addressof(record), true, true, timeout);
+    }
+
+    /**
+     * Hands the element over to a consumer only if some consumer is
+     * already waiting. This method returns immediately.
+     *
+     * @param record element to hand over
+     * @return false if there were no waiting consumers, true otherwise
+     */
+    bool offer(T record) {
+        if (0 == consumers_count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return transfer(std::addressof(record), true, false, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * Takes the element from a producer, waits for it infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param record move the element to given variable
+     * @param timeout max amount of milliseconds to wait for the producer,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return false if the queue was unblocked or timeout expired, true otherwise
+     */
+    bool take(T& record, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        return transfer(std::addressof(record), false, true, timeout);
+    }
+
+    /**
+     * Takes the element only if some producer is already waiting.
+     * This method returns immediately.
+     *
+     * @param record move the element to given variable
+     * @return false if there were no waiting producers, true otherwise
+     */
+    bool poll(T& record) {
+        if (0 == producers_count.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return transfer(std::addressof(record), false, false, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * Unblocks the queue, all the waiting producers and consumers
+     * return false, queue cannot be used for waiting after this call.
+     */
+    void unblock() {
+        std::lock_guard<spin_mutex> guard{mutex};
+        unblocked.store(true, std::memory_order_release);
+        while (nullptr != head) {
+            waiter_node* nd = head;
+            unlink(*nd);
+            wake(*nd, cancelled);
+        }
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the number of producers waiting for consumers
+     *
+     * @return number of waiting producers
+     */
+    size_t waiting_producers() const {
+        return producers_count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the number of consumers waiting for producers
+     *
+     * @return number of waiting consumers
+     */
+    size_t waiting_consumers() const {
+        return consumers_count.load(std::memory_order_acquire);
+    }
+
+private:
+    bool transfer(T* elem, bool producer, bool block, std::chrono::milliseconds timeout) {
+        waiter_node node{elem, producer};
+        {
+            std::lock_guard<spin_mutex> guard{mutex};
+            if (nullptr != head && head->producer != producer) {
+                waiter_node* nd = head;
+                // element is moved first, if it throws, counterpart stays queued
+                if (producer) {
+                    *nd->elem = std::move(*elem);
+                } else {
+                    *elem = std::move(*nd->elem);
+                }
+                unlink(*nd);
+                wake(*nd, matched);
+                return true;
+            }
+            if (!block || unblocked.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            enqueue(node);
+        }
+        return await(node, timeout);
+    }
+
+    bool await(waiter_node& node, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (size_t i = 0; i < spins_count; i++) {
+            if (waiting != node.state.load(std::memory_order_acquire)) {
+                return matched == node.state.load(std::memory_order_relaxed);
+            }
+            std::this_thread::yield();
+        }
+        if (std::chrono::milliseconds(0) == timeout) {
+            atomic_wait(node.state, waiting);
+        } else if (!atomic_wait_until(node.state, waiting, deadline)) {
+            std::lock_guard<spin_mutex> guard{mutex};
+            if (waiting == node.state.load(std::memory_order_acquire)) {
+                unlink(node);
+                return false;
+            }
+        }
+        return matched == node.state.load(std::memory_order_acquire);
+    }
+
+    void wake(waiter_node& node, uint32_t state) {
+        std::atomic<uint32_t>& st = node.state;
+        st.store(state, std::memory_order_release);
+        // node may be already destroyed, only its address is used
+        atomic_notify_one(st);
+    }
+
+    void enqueue(waiter_node& node) {
+        node.prev = tail;
+        if (nullptr != tail) {
+            tail->next = std::addressof(node);
+        } else {
+            head = std::addressof(node);
+        }
+        tail = std::addressof(node);
+        counter_for(node).fetch_add(1, std::memory_order_release);
+    }
+
+    void unlink(waiter_node& node) {
+        if (nullptr != node.prev) {
+            node.prev->next = node.next;
+        } else {
+            head = node.next;
+        }
+        if (nullptr != node.next) {
+            node.next->prev = node.prev;
+        } else {
+            tail = node.prev;
+        }
+        node.prev = nullptr;
+        node.next = nullptr;
+        counter_for(node).fetch_sub(1, std::memory_order_release);
+    }
+
+    std::atomic<size_t>& counter_for(const waiter_node& node) {
+        return node.producer ? producers_count : consumers_count;
+    }
+
+};
+
+template<typename T>
+const uint32_t synchronous_queue<T>::waiting;
+
+template<typename T>
+const uint32_t synchronous_queue<T>::matched;
+
+template<typename T>
+const uint32_t synchronous_queue<T>::cancelled;
+
+template<typename T>
+const size_t synchronous_queue<T>::spins_count;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_SYNCHRONOUS_QUEUE_HPP */
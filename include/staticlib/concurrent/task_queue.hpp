@@ -0,0 +1,285 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   task_queue.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:42 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_TASK_QUEUE_HPP
+#define STATICLIB_CONCURRENT_TASK_QUEUE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/inplace_task.hpp"
+
+// based on: http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Bounded lock-free MPMC queue of `inplace_task` callables, functors are
+ * constructed directly inside the fixed-size ring slots, so task handoff
+ * does not allocate unless the functor is larger than `Capacity` bytes;
+ * supports optional blocking `take` operation
+ */
+template<size_t Capacity = 64>
+class task_queue : public std::enable_shared_from_this<task_queue<Capacity>> {
+    class slot {
+    public:
+        std::atomic<size_t> sequence;
+        inplace_task<Capacity> task;
+    };
+
+    const size_t mask;
+    std::unique_ptr<slot[]> slots;
+    char padding1[64];
+    std::atomic<size_t> enqueue_pos;
+    char padding2[64 - sizeof (std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_pos;
+    char padding3[64 - sizeof (std::atomic<size_t>)];
+    eventcount empty_ec;
+    std::atomic<bool> unblocked;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = inplace_task<Capacity>;
+
+    /**
+     * Constructor
+     *
+     * @param size queue size, rounded up to the power of 2
+     */
+    explicit task_queue(size_t size) :
+    mask(round_up(size) - 1),
+    slots(new slot[mask + 1]),
+    enqueue_pos(0),
+    dequeue_pos(0),
+    unblocked(false) {
+        for (size_t i = 0; i <= mask; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    task_queue(const task_queue&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    task_queue& operator=(const task_queue&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    task_queue(task_queue&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    task_queue& operator=(task_queue&&) = delete;
+
+    /**
+     * Emplace a functor at the end of the queue
+     *
+     * @param func functor to enqueue
+     * @return false if the queue was full, true otherwise
+     */
+    template<typename Func>
+    bool emplace(Func&& func) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        slot* sl = nullptr;
+        for (;;) {
+            sl = std::addressof(slots[pos & mask]);
+            size_t seq = sl->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (0 == diff) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // queue is full
+                return false;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        try {
+            sl->task.emplace(std::forward<Func>(func));
+        } catch (...) {
+            // slot is already claimed, empty task is published
+            // and skipped by consumers, so the ring is not stalled
+            sl->task.reset();
+            sl->sequence.store(pos + 1, std::memory_order_release);
+            throw;
+        }
+        sl->sequence.store(pos + 1, std::memory_order_release);
+        empty_ec.notify_one();
+        return true;
+    }
+
+    /**
+     * Attempt to read the task at the front to the queue into a variable.
+     * This method returns immediately.
+     *
+     * @param task move the task at the front of the queue to given variable
+     * @return returns false if queue was empty, true otherwise
+     */
+    bool poll(value_type& task) {
+        for (;;) {
+            if (!poll_slot(task)) {
+                return false;
+            }
+            if (task) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Attempt to read the task at the front of the queue into a variable.
+     * This method will wait on empty queue infinitely (by default),
+     * or up to specified amount of milliseconds
+     *
+     * @param task move the task at the front of the queue to given variable
+     * @param timeout max amount of milliseconds to wait on empty queue,
+     *        zero value (supplied by default) will cause infinite wait
+     * @return returns false if queue was empty after timeout, true otherwise
+     */
+    bool take(value_type& task, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (poll(task)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            auto key = empty_ec.prepare_wait();
+            if (poll(task)) {
+                empty_ec.cancel_wait();
+                return true;
+            }
+            if (unblocked.load(std::memory_order_acquire)) {
+                empty_ec.cancel_wait();
+                return false;
+            }
+            if (std::chrono::milliseconds(0) == timeout) {
+                empty_ec.wait(key);
+            } else if (!empty_ec.wait_until(key, deadline)) {
+                return poll(task);
+            }
+        }
+    }
+
+    /**
+     * Unblocks the queue allowing consumers to
+     * exit 'take' calls. Queue cannot be used
+     * for waiting on it after this call.
+     */
+    void unblock() {
+        unblocked.store(true, std::memory_order_release);
+        empty_ec.notify_all();
+    }
+
+    /**
+     * Checks whether this queue was unblocked
+     *
+     * @return whether this queue was unblocked
+     */
+    bool is_unblocked() const {
+        return unblocked.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check if the queue is empty, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return whether queue is empty
+     */
+    bool empty() const {
+        return 0 == size();
+    }
+
+    /**
+     * Returns the number of entries in the queue, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return number of entries in the queue
+     */
+    size_t size() const {
+        size_t deq = dequeue_pos.load(std::memory_order_acquire);
+        size_t enq = enqueue_pos.load(std::memory_order_acquire);
+        return enq > deq ? enq - deq : 0;
+    }
+
+    /**
+     * Accessor for max queue size
+     *
+     * @return max queue size
+     */
+    size_t max_size() const {
+        return mask + 1;
+    }
+
+private:
+    // returns empty task for the slot, whose emplace has thrown
+    bool poll_slot(value_type& task) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        slot* sl = nullptr;
+        for (;;) {
+            sl = std::addressof(slots[pos & mask]);
+            size_t seq = sl->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (0 == diff) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // queue is empty
+                return false;
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        task = std::move(sl->task);
+        sl->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    static size_t round_up(size_t size) {
+        size_t res = 2;
+        while (res < size) {
+            res <<= 1;
+        }
+        return res;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_TASK_QUEUE_HPP */
@@ -0,0 +1,494 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   thread_pool_executor.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:05 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_THREAD_POOL_EXECUTOR_HPP
+#define STATICLIB_CONCURRENT_THREAD_POOL_EXECUTOR_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "staticlib/concurrent/eventcount.hpp"
+#include "staticlib/concurrent/mpmc_blocking_queue.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_thread_pool_executor {
+
+class task_base {
+public:
+    virtual ~task_base() { }
+
+    virtual void run() = 0;
+};
+
+template<typename R>
+class result_holder {
+    typename std::aligned_storage<sizeof (R), std::alignment_of<R>::value>::type storage;
+    bool has_value = false;
+
+public:
+    result_holder() { }
+
+    result_holder(const result_holder&) = delete;
+
+    result_holder& operator=(const result_holder&) = delete;
+
+    ~result_holder() {
+        if (has_value) {
+            reinterpret_cast<R*> (std::addressof(storage))->~R();
+        }
+    }
+
+    template<typename Func>
+    void set_from(Func& func) {
+        new (std::addressof(storage)) R(func());
+        has_value = true;
+    }
+
+    R take() {
+        return std::move(*reinterpret_cast<R*> (std::addressof(storage)));
+    }
+};
+
+// referenced object is owned by the caller
+template<typename R>
+class result_holder<R&> {
+    R* ptr = nullptr;
+
+public:
+    template<typename Func>
+    void set_from(Func& func) {
+        ptr = std::addressof(func());
+    }
+
+    R& take() {
+        return *ptr;
+    }
+};
+
+template<>
+class result_holder<void> {
+public:
+    template<typename Func>
+    void set_from(Func& func) {
+        func();
+    }
+
+    void take() { }
+};
+
+// rvalue references are returned as values, lvalue references as is
+template<typename R>
+class future_result {
+public:
+    using type = R;
+};
+
+template<typename R>
+class future_result<R&&> {
+public:
+    using type = R;
+};
+
+template<typename R>
+class future_state : public task_base {
+    std::atomic<bool> ready;
+    eventcount ready_ec;
+
+protected:
+    std::exception_ptr exception;
+    result_holder<R> result;
+
+    void complete() {
+        ready.store(true, std::memory_order_release);
+        ready_ec.notify_all();
+    }
+
+public:
+    future_state() :
+    ready(false) { }
+
+    bool is_ready() const {
+        return ready.load(std::memory_order_acquire);
+    }
+
+    void await() {
+        ready_ec.await([this] {
+            return this->is_ready();
+        });
+    }
+
+    bool await_until(const std::chrono::steady_clock::time_point& deadline) {
+        return ready_ec.await_until([this] {
+            return this->is_ready();
+        }, deadline);
+    }
+
+    R take() {
+        if (nullptr != exception) {
+            std::rethrow_exception(exception);
+        }
+        return result.take();
+    }
+};
+
+template<typename R, typename Func>
+class task_state : public future_state<R> {
+    Func func;
+
+public:
+    explicit task_state(Func&& func) :
+    func(std::move(func)) { }
+
+    virtual void run() override {
+        try {
+            this->result.set_from(func);
+        } catch (...) {
+            this->exception = std::current_exception();
+        }
+        this->complete();
+    }
+};
+
+template<typename Func>
+class detached_task : public task_base {
+    Func func;
+
+public:
+    explicit detached_task(Func&& func) :
+    func(std::move(func)) { }
+
+    virtual void run() override {
+        try {
+            func();
+        } catch (...) {
+            // exceptions from detached tasks are ignored
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * Lightweight future returned from `thread_pool_executor::submit`,
+ * shares the single allocation with the submitted task, completion
+ * is signalled without taking any locks when there are no waiters
+ */
+template<typename R>
+class task_future {
+    std::shared_ptr<detail_thread_pool_executor::future_state<R>> state;
+
+public:
+    /**
+     * Constructor, creates invalid future
+     */
+    task_future() { }
+
+    /**
+     * Constructor
+     *
+     * @param state shared state
+     */
+    explicit task_future(std::shared_ptr<detail_thread_pool_executor::future_state<R>> state) :
+    state(std::move(state)) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    task_future(const task_future&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    task_future& operator=(const task_future&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    task_future(task_future&& other) :
+    state(std::move(other.state)) { }
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    task_future& operator=(task_future&& other) {
+        state = std::move(other.state);
+        return *this;
+    }
+
+    /**
+     * Checks whether this future is associated with a task,
+     * future is invalid if the task was rejected by executor
+     * or if the result was already taken with `get`
+     *
+     * @return whether this future is valid
+     */
+    bool valid() const {
+        return nullptr != state.get();
+    }
+
+    /**
+     * Checks whether the task is completed
+     *
+     * @return whether the task is completed
+     */
+    bool ready() const {
+        return state->is_ready();
+    }
+
+    /**
+     * Waits for the task to complete
+     */
+    void wait() const {
+        state->await();
+    }
+
+    /**
+     * Waits for the task to complete or for the
+     * specified timeout to expire
+     *
+     * @param timeout max time period to wait
+     * @return false if exit on timeout expiry, true otherwise
+     */
+    bool wait_for(std::chrono::milliseconds timeout) const {
+        return state->await_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * Waits for the task to complete and returns its result,
+     * rethrows the exception thrown by the task; future becomes
+     * invalid after this call
+     *
+     * @return task result
+     */
+    R get() {
+        state->await();
+        auto st = std::move(state);
+        return st->take();
+    }
+};
+
+/**
+ * Fixed-size thread pool that runs the tasks from `mpmc_blocking_queue`,
+ * `submit` returns lightweight `task_future`, workers exit through
+ * the queue `unblock()` after all the pending tasks are executed
+ */
+class thread_pool_executor : public std::enable_shared_from_this<thread_pool_executor> {
+    mpmc_blocking_queue<std::shared_ptr<detail_thread_pool_executor::task_base>> queue;
+    std::vector<std::thread> threads;
+    // immutable after construction, 'threads' are modified on join
+    std::vector<std::thread::id> thread_ids;
+    std::mutex join_mutex;
+    std::atomic<bool> shut_down;
+    std::atomic<size_t> submitting;
+
+public:
+    /**
+     * Constructor, starts worker threads
+     *
+     * @param threads_count number of worker threads, zero value
+     *        (supplied by default) means hardware concurrency
+     * @param max_queue_size max number of pending tasks, zero value
+     *        (supplied by default) means unbounded queue
+     */
+    explicit thread_pool_executor(size_t threads_count = 0, size_t max_queue_size = 0) :
+    queue(max_queue_size),
+    shut_down(false),
+    submitting(0) {
+        size_t count = threads_count > 0 ? threads_count : std::thread::hardware_concurrency();
+        if (0 == count) {
+            count = 1;
+        }
+        for (size_t i = 0; i < count; i++) {
+            threads.emplace_back([this] {
+                std::shared_ptr<detail_thread_pool_executor::task_base> task;
+                while (this->queue.take(task)) {
+                    task->run();
+                    task.reset();
+                }
+            });
+            thread_ids.push_back(threads.back().get_id());
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    thread_pool_executor(const thread_pool_executor&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    thread_pool_executor& operator=(const thread_pool_executor&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    thread_pool_executor(thread_pool_executor&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    thread_pool_executor& operator=(thread_pool_executor&&) = delete;
+
+    /**
+     * Destructor, shuts down the executor and joins worker threads,
+     * must not be called from the tasks running on this executor
+     * (precondition is checked with `assert` in debug builds)
+     */
+    ~thread_pool_executor() {
+        assert(!is_worker_thread());
+        shutdown();
+    }
+
+    /**
+     * Submits specified functor for the execution
+     *
+     * @param func task functor
+     * @return future for the functor result, invalid future
+     *         if the queue is full or executor is shut down
+     */
+    template<typename Func,
+            typename R = typename detail_thread_pool_executor::future_result<
+                    decltype(std::declval<typename std::decay<Func>::type&>()())>::type>
+    task_future<R> submit(Func&& func) {
+        using func_type = typename std::decay<Func>::type;
+        using state_type = detail_thread_pool_executor::task_state<R, func_type>;
+        auto state = std::make_shared<state_type>(func_type(std::forward<Func>(func)));
+        std::shared_ptr<detail_thread_pool_executor::future_state<R>> fstate = state;
+        if (!enqueue(std::move(state))) {
+            return task_future<R>();
+        }
+        return task_future<R>(std::move(fstate));
+    }
+
+    /**
+     * Submits specified functor for the execution without creating
+     * a future, exceptions thrown from the functor are ignored
+     *
+     * @param func task functor
+     * @return false if the queue is full or executor is shut down, true otherwise
+     */
+    template<typename Func>
+    bool execute(Func&& func) {
+        using func_type = typename std::decay<Func>::type;
+        using task_type = detail_thread_pool_executor::detached_task<func_type>;
+        return enqueue(std::make_shared<task_type>(func_type(std::forward<Func>(func))));
+    }
+
+    /**
+     * Stops accepting new tasks, waits for the pending tasks
+     * to complete and joins worker threads. When called from a task
+     * running on this executor, returns without waiting, worker threads
+     * exit after the pending tasks and are joined by the destructor.
+     */
+    void shutdown() {
+        if (!shut_down.exchange(true, std::memory_order_seq_cst)) {
+            // let concurrent 'submit' calls finish their 'emplace'
+            while (submitting.load(std::memory_order_seq_cst) > 0) {
+                std::this_thread::yield();
+            }
+            queue.unblock();
+        }
+        if (is_worker_thread()) {
+            // worker cannot join itself, and other workers
+            // may be joining it from their own tasks
+            return;
+        }
+        std::lock_guard<std::mutex> guard{join_mutex};
+        for (auto& th : threads) {
+            if (th.joinable()) {
+                th.join();
+            }
+        }
+    }
+
+    /**
+     * Checks whether this executor was shut down
+     *
+     * @return whether this executor was shut down
+     */
+    bool is_shut_down() const {
+        return shut_down.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Accessor for the number of worker threads
+     *
+     * @return number of worker threads
+     */
+    size_t threads_count() const {
+        return threads.size();
+    }
+
+    /**
+     * Returns the number of tasks waiting in the queue
+     *
+     * @return number of pending tasks
+     */
+    size_t queue_size() const {
+        return queue.size();
+    }
+
+private:
+    bool is_worker_thread() const {
+        auto id = std::this_thread::get_id();
+        for (auto& tid : thread_ids) {
+            if (id == tid) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool enqueue(std::shared_ptr<detail_thread_pool_executor::task_base> task) {
+        submitting.fetch_add(1, std::memory_order_seq_cst);
+        bool res = false;
+        if (!shut_down.load(std::memory_order_seq_cst)) {
+            res = queue.emplace(std::move(task));
+        }
+        submitting.fetch_sub(1, std::memory_order_seq_cst);
+        return res;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_THREAD_POOL_EXECUTOR_HPP */
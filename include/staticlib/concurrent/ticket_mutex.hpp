@@ -0,0 +1,136 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   ticket_mutex.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:35 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_TICKET_MUTEX_HPP
+#define STATICLIB_CONCURRENT_TICKET_MUTEX_HPP
+
+#include <cstdint>
+#include <atomic>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Fair (FIFO) mutex, threads are granted the lock in the order
+ * of their arrival. Waiters spin for a while and then block using
+ * `atomic_wait`, all blocked threads are woken on unlock, so it is
+ * intended for the small number of contending threads.
+ * Satisfies `Lockable` requirements, can be used with `std::unique_lock`
+ * and `std::condition_variable_any` (`eventcount_condition` is cheaper).
+ */
+class ticket_mutex {
+    // serving word: now serving - bits 0-31 (futex word), blocked threads - bits 32-63
+    static const uint64_t sleeper_one = 1ULL << 32;
+    static const size_t spins_count = 100;
+
+    std::atomic<uint32_t> next_ticket;
+    char padding[64 - sizeof (std::atomic<uint32_t>)];
+    std::atomic<uint64_t> serving;
+
+public:
+    /**
+     * Constructor
+     */
+    ticket_mutex() :
+    next_ticket(0),
+    serving(0) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    ticket_mutex(const ticket_mutex&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    ticket_mutex& operator=(const ticket_mutex&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    ticket_mutex(ticket_mutex&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    ticket_mutex& operator=(ticket_mutex&&) = delete;
+
+    /**
+     * Locks the mutex, blocks if the mutex is not available
+     */
+    void lock() {
+        uint32_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < spins_count; i++) {
+            if (ticket == now_serving(serving.load(std::memory_order_acquire))) {
+                return;
+            }
+        }
+        uint64_t word = serving.fetch_add(sleeper_one, std::memory_order_seq_cst) + sleeper_one;
+        while (ticket != now_serving(word)) {
+            atomic_wait(serving, word);
+            word = serving.load(std::memory_order_seq_cst);
+        }
+        serving.fetch_sub(sleeper_one, std::memory_order_relaxed);
+    }
+
+    /**
+     * Tries to lock the mutex, returns immediately
+     *
+     * @return true if the mutex was locked, false otherwise
+     */
+    bool try_lock() {
+        uint32_t ticket = now_serving(serving.load(std::memory_order_acquire));
+        uint32_t expected = ticket;
+        return next_ticket.compare_exchange_strong(expected, ticket + 1, std::memory_order_acquire,
+                std::memory_order_relaxed);
+    }
+
+    /**
+     * Unlocks the mutex
+     */
+    void unlock() {
+        uint64_t word = serving.load(std::memory_order_relaxed);
+        uint64_t updated = 0;
+        do {
+            // serving counter wraps around without carrying into the sleepers count
+            updated = (word & ~0xFFFFFFFFULL) | static_cast<uint32_t> (now_serving(word) + 1);
+        } while (!serving.compare_exchange_weak(word, updated, std::memory_order_seq_cst,
+                std::memory_order_relaxed));
+        if (updated >= sleeper_one) {
+            atomic_notify_all(serving);
+        }
+    }
+
+private:
+    static uint32_t now_serving(uint64_t word) {
+        return static_cast<uint32_t> (word & 0xFFFFFFFF);
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_TICKET_MUTEX_HPP */
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   triple_buffer.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:40 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_TRIPLE_BUFFER_HPP
+#define STATICLIB_CONCURRENT_TRIPLE_BUFFER_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Wait-free exchange of the latest state between a single producer
+ * and a single consumer. Producer fills its back buffer and publishes it,
+ * consumer picks up the most recently published buffer, older unconsumed
+ * ones are overwritten. Buffers are never copied or moved, only their indices
+ * are exchanged, so buffers can be reused between frames by both sides.
+ */
+template<typename T>
+class triple_buffer : public std::enable_shared_from_this<triple_buffer<T>> {
+    static const uint32_t index_mask = 3;
+    static const uint32_t dirty_flag = 4;
+
+    class slot {
+    public:
+        T value;
+        char padding[64];
+
+        slot() :
+        value() { }
+    };
+
+    slot slots[3];
+    // index of the middle buffer | dirty flag
+    std::atomic<uint32_t> middle;
+    char padding1[64];
+    // producer only
+    uint32_t back_idx;
+    char padding2[64];
+    // consumer only
+    uint32_t front_idx;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor, all buffers are value-initialized
+     */
+    triple_buffer() :
+    middle(1),
+    back_idx(0),
+    front_idx(2) { }
+
+    /**
+     * Constructor
+     *
+     * @param initial value to copy into all three buffers
+     */
+    explicit triple_buffer(const T& initial) :
+    middle(1),
+    back_idx(0),
+    front_idx(2) {
+        for (slot& sl : slots) {
+            sl.value = initial;
+        }
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    triple_buffer(const triple_buffer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    triple_buffer& operator=(const triple_buffer&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    triple_buffer(triple_buffer&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    triple_buffer& operator=(triple_buffer&&) = delete;
+
+    /**
+     * Accessor for the producer's back buffer, it contains the value
+     * from one of the previous frames and should be overwritten
+     *
+     * @return reference to the back buffer
+     */
+    T& back() {
+        return slots[back_idx].value;
+    }
+
+    /**
+     * Publishes the back buffer, previously published buffer
+     * becomes the new back buffer if it was not picked up
+     */
+    void publish() {
+        uint32_t prev = middle.exchange(back_idx | dirty_flag, std::memory_order_acq_rel);
+        back_idx = prev & index_mask;
+    }
+
+    /**
+     * Copies the specified value into the back buffer and publishes it
+     *
+     * @param value value to publish
+     */
+    void write(const T& value) {
+        back() = value;
+        publish();
+    }
+
+    /**
+     * Checks whether a buffer was published after the last `update` call
+     *
+     * @return true if new buffer is available, false otherwise
+     */
+    bool has_update() const {
+        return 0 != (middle.load(std::memory_order_relaxed) & dirty_flag);
+    }
+
+    /**
+     * Picks up the most recently published buffer, if any,
+     * front buffer is not changed if nothing was published
+     *
+     * @return true if the front buffer was replaced, false otherwise
+     */
+    bool update() {
+        if (!has_update()) {
+            return false;
+        }
+        uint32_t prev = middle.exchange(front_idx, std::memory_order_acq_rel);
+        front_idx = prev & index_mask;
+        return true;
+    }
+
+    /**
+     * Accessor for the consumer's front buffer, it stays valid
+     * and unchanged until the next `update` call
+     *
+     * @return reference to the front buffer
+     */
+    T& front() {
+        return slots[front_idx].value;
+    }
+
+    /**
+     * Picks up the most recently published buffer and returns it
+     *
+     * @return reference to the front buffer
+     */
+    T& read() {
+        update();
+        return front();
+    }
+
+};
+
+template<typename T>
+const uint32_t triple_buffer<T>::index_mask;
+
+template<typename T>
+const uint32_t triple_buffer<T>::dirty_flag;
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_TRIPLE_BUFFER_HPP */
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   wait_group.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:10 PM
+ */
+
+#ifndef STATICLIB_CONCURRENT_WAIT_GROUP_HPP
+#define STATICLIB_CONCURRENT_WAIT_GROUP_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+namespace staticlib {
+namespace concurrent {
+
+/**
+ * Counter of pending operations similar to `sync.WaitGroup` from Go,
+ * the counter can be incremented with `add` at any time while there are
+ * pending operations, `wait` blocks until the counter goes to zero.
+ * Counter is split into multiple shards selected by thread id, so
+ * concurrent `add` and `done` calls do not contend on a single cache line.
+ * While there are parked waiters, shards are drained into a single shared counter
+ * and all updates go there, so `done` detects the zero transition with one atomic
+ * decrement instead of scanning the shards.
+ * Wait group can be destroyed by a waiter right after the `wait` returns.
+ */
+class wait_group : public std::enable_shared_from_this<wait_group> {
+    static const size_t max_shards = 64;
+
+    class shard {
+    public:
+        // signed, 'add' and 'done' for the same operation may land on different shards
+        std::atomic<int64_t> count;
+        // number of 'add' and 'done' calls in progress, indexed by the drain phase
+        // they started in, drain waits only for the calls of the previous phase
+        std::atomic<uint32_t> busy[2];
+        char padding[64 - sizeof (std::atomic<int64_t>) - 2 * sizeof (std::atomic<uint32_t>)];
+
+        shard() :
+        count(0) {
+            busy[0].store(0, std::memory_order_relaxed);
+            busy[1].store(0, std::memory_order_relaxed);
+        }
+    };
+
+    const size_t shards_mask;
+    std::unique_ptr<shard[]> shards;
+    // holds the whole counter value while 'waiters' is non-zero
+    std::atomic<int64_t> central;
+    std::atomic<uint32_t> waiters;
+    std::atomic<uint32_t> epoch;
+    // flipped by every drain, updates that started
+    // in the previous phase are waited for
+    std::atomic<uint32_t> phase;
+    // concurrent waiters must not check 'central' while another one is draining
+    std::mutex drain_mutex;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param shards_count number of counter shards, rounded up to the power of 2
+     *        and limited to 64, zero value (supplied by default) means hardware concurrency
+     */
+    explicit wait_group(size_t shards_count = 0) :
+    shards_mask(round_up(shards_count > 0 ? shards_count : std::thread::hardware_concurrency()) - 1),
+    shards(new shard[shards_mask + 1]),
+    central(0),
+    waiters(0),
+    epoch(0),
+    phase(0) { }
+
+    /**
+     * Deleted copy constructor
+     */
+    wait_group(const wait_group&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    wait_group& operator=(const wait_group&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    wait_group(wait_group&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    wait_group& operator=(wait_group&&) = delete;
+
+    /**
+     * Increments the counter, must be called before
+     * starting the operations that will call `done`
+     *
+     * @param count number of operations to add, 1 by default
+     */
+    void add(size_t count = 1) {
+        update(static_cast<int64_t> (count));
+    }
+
+    /**
+     * Decrements the counter, wakes the waiters if the counter goes to zero
+     */
+    void done() {
+        update(-1);
+    }
+
+    /**
+     * Blocks until the counter goes to zero
+     */
+    void wait() {
+        enter_waiting();
+        for (;;) {
+            uint32_t key = epoch.load(std::memory_order_acquire);
+            if (0 == central.load(std::memory_order_acquire)) {
+                break;
+            }
+            atomic_wait(epoch, key);
+        }
+        waiters.fetch_sub(1, std::memory_order_release);
+        await_quiescence();
+    }
+
+    /**
+     * Blocks until the counter goes to zero or until
+     * specified timeout will be expired
+     *
+     * @param timeout max time period to wait
+     * @return false if exit on timeout expiry, true otherwise
+     */
+    bool wait_for(std::chrono::milliseconds timeout) {
+        return wait_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * Blocks until the counter goes to zero or until
+     * the deadline is reached
+     *
+     * @param deadline time point to wait until
+     * @return false if exit on deadline, true otherwise
+     */
+    bool wait_until(const std::chrono::steady_clock::time_point& deadline) {
+        bool res = true;
+        enter_waiting();
+        for (;;) {
+            uint32_t key = epoch.load(std::memory_order_acquire);
+            if (0 == central.load(std::memory_order_acquire)) {
+                break;
+            }
+            if (!atomic_wait_until(epoch, key, deadline)) {
+                res = 0 == central.load(std::memory_order_acquire);
+                break;
+            }
+        }
+        waiters.fetch_sub(1, std::memory_order_release);
+        if (res) {
+            await_quiescence();
+        }
+        return res;
+    }
+
+    /**
+     * Returns the value of the counter, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return counter value
+     */
+    size_t count() const {
+        int64_t sum = central.load(std::memory_order_acquire);
+        for (size_t i = 0; i <= shards_mask; i++) {
+            sum += shards[i].count.load(std::memory_order_acquire);
+        }
+        return sum > 0 ? static_cast<size_t> (sum) : 0;
+    }
+
+private:
+    static size_t round_up(size_t size) {
+        size_t res = 1;
+        while (res < size && res < max_shards) {
+            res <<= 1;
+        }
+        return res;
+    }
+
+    shard& current_shard() {
+        size_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        return shards[(hash ^ (hash >> 16)) & shards_mask];
+    }
+
+    void update(int64_t delta) {
+        shard& sh = current_shard();
+        uint32_t ph = enter_phase(sh);
+        if (0 == waiters.load(std::memory_order_relaxed)) {
+            sh.count.fetch_add(delta, std::memory_order_acq_rel);
+        } else if (0 == central.fetch_add(delta, std::memory_order_acq_rel) + delta) {
+            wake_waiters();
+        }
+        sh.busy[ph].fetch_sub(1, std::memory_order_release);
+    }
+
+    uint32_t enter_phase(shard& sh) {
+        for (;;) {
+            uint32_t ph = phase.load(std::memory_order_relaxed);
+            sh.busy[ph].fetch_add(1, std::memory_order_acq_rel);
+            // pairs with the fence in enter_waiting, either this update sees the flipped
+            // phase and retries, or the drain sees it in progress and waits for it
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ph == phase.load(std::memory_order_relaxed)) {
+                return ph;
+            }
+            sh.busy[ph].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // after this call all shards are drained and the counter
+    // is updated only in 'central' until the waiter leaves
+    void enter_waiting() {
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> guard{drain_mutex};
+        uint32_t prev = phase.load(std::memory_order_relaxed);
+        phase.store(prev ^ 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (size_t i = 0; i <= shards_mask; i++) {
+            shard& sh = shards[i];
+            // calls started after the flip do not hold 'prev', so this wait is finite
+            // under steady traffic, calls that can still update the shard hold it
+            while (sh.busy[prev].load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+            int64_t drained = sh.count.exchange(0, std::memory_order_acq_rel);
+            if (0 != drained && 0 == central.fetch_add(drained, std::memory_order_acq_rel) + drained) {
+                wake_waiters();
+            }
+        }
+    }
+
+    void wake_waiters() {
+        epoch.fetch_add(1, std::memory_order_release);
+        atomic_notify_all(epoch);
+    }
+
+    void await_quiescence() {
+        for (size_t i = 0; i <= shards_mask; i++) {
+            while (shards[i].busy[0].load(std::memory_order_acquire) > 0 ||
+                    shards[i].busy[1].load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_WAIT_GROUP_HPP */
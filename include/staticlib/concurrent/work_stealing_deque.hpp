@@ -0,0 +1,236 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   work_stealing_deque.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:47 AM
+ */
+
+#ifndef STATICLIB_CONCURRENT_WORK_STEALING_DEQUE_HPP
+#define STATICLIB_CONCURRENT_WORK_STEALING_DEQUE_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// based on: "Correct and Efficient Work-Stealing for Weak Memory Models", Le, Pop, Cohen, Nardelli, PPoPP 2013
+
+namespace staticlib {
+namespace concurrent {
+
+namespace detail_work_stealing_deque {
+
+template<typename T>
+class ring_array {
+    const int64_t array_size;
+    std::unique_ptr<std::atomic<T>[]> records;
+
+public:
+    explicit ring_array(int64_t size) :
+    array_size(size),
+    records(new std::atomic<T>[static_cast<size_t>(size)]) { }
+
+    int64_t size() const {
+        return array_size;
+    }
+
+    T get(int64_t idx) const {
+        return records[static_cast<size_t>(idx & (array_size - 1))].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t idx, T value) {
+        records[static_cast<size_t>(idx & (array_size - 1))].store(value, std::memory_order_relaxed);
+    }
+};
+
+} // namespace
+
+/**
+ * Chase-Lev unbounded work-stealing deque, owner thread pushes and pops
+ * elements at the bottom (LIFO), any other threads steal elements from the
+ * top (FIFO). Elements must be trivially copyable (usually pointers to tasks).
+ */
+template<typename T>
+class work_stealing_deque : public std::enable_shared_from_this<work_stealing_deque<T>> {
+    using array_type = detail_work_stealing_deque::ring_array<T>;
+
+    std::atomic<int64_t> top;
+    // separate cache lines for owner and thieves
+    char padding[64 - sizeof (std::atomic<int64_t>)];
+    std::atomic<int64_t> bottom;
+    std::atomic<array_type*> array;
+    // previous arrays are retained until destruction, thieves may still read them
+    std::vector<std::unique_ptr<array_type>> arrays;
+
+public:
+    /**
+     * Type of elements
+     */
+    using value_type = T;
+
+    /**
+     * Constructor
+     *
+     * @param initial_size initial capacity, rounded up to the power of 2
+     */
+    explicit work_stealing_deque(size_t initial_size = 64) :
+    top(0),
+    bottom(0),
+    array(nullptr) {
+        int64_t size = 2;
+        while (size < static_cast<int64_t>(initial_size)) {
+            size <<= 1;
+        }
+        arrays.emplace_back(new array_type(size));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    /**
+     * Deleted copy constructor
+     */
+    work_stealing_deque(const work_stealing_deque&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     */
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    /**
+     * Deleted move constructor
+     */
+    work_stealing_deque(work_stealing_deque&&) = delete;
+
+    /**
+     * Deleted move assignment operator
+     */
+    work_stealing_deque& operator=(work_stealing_deque&&) = delete;
+
+    /**
+     * Push a value at the bottom of the deque, grows the storage if necessary,
+     * must be called only from the owner thread
+     *
+     * @param value value to push
+     */
+    void push(T value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        array_type* a = array.load(std::memory_order_relaxed);
+        if (b - t > a->size() - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, value);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * Attempt to pop the value from the bottom of the deque (most recently pushed),
+     * must be called only from the owner thread
+     *
+     * @param record the value from the bottom of the deque
+     * @return false if deque was empty, true otherwise
+     */
+    bool pop(T& record) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        array_type* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        T value = a->get(b);
+        if (t == b) {
+            // last element, race with thieves
+            bool won = top.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return false;
+            }
+        }
+        record = value;
+        return true;
+    }
+
+    /**
+     * Attempt to steal the value from the top of the deque (least recently pushed),
+     * can be called from any thread; may fail spuriously when racing with other
+     * thieves or with the owner
+     *
+     * @param record the value from the top of the deque
+     * @return false if deque was empty or the race was lost, true otherwise
+     */
+    bool steal(T& record) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        array_type* a = array.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        record = value;
+        return true;
+    }
+
+    /**
+     * Check if the deque is empty, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return whether deque is empty
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * Returns the number of elements in the deque, result is approximate
+     * if called concurrently with other operations
+     *
+     * @return number of elements in the deque
+     */
+    size_t size() const {
+        int64_t b = bottom.load(std::memory_order_acquire);
+        int64_t t = top.load(std::memory_order_acquire);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+private:
+    array_type* grow(array_type* a, int64_t t, int64_t b) {
+        arrays.emplace_back(new array_type(a->size() * 2));
+        array_type* na = arrays.back().get();
+        for (int64_t i = t; i < b; i++) {
+            na->put(i, a->get(i));
+        }
+        array.store(na, std::memory_order_release);
+        return na;
+    }
+
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_CONCURRENT_WORK_STEALING_DEQUE_HPP */
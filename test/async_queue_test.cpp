@@ -0,0 +1,279 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 7:30 AM
+ */
+
+#include "staticlib/concurrent/async_queue.hpp"
+
+#include <iostream>
+
+#include "staticlib/config/assert.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/concurrent/countdown_latch.hpp"
+#include "staticlib/concurrent/thread_pool_executor.hpp"
+
+// fire-and-forget coroutine
+class detached {
+public:
+    class promise_type {
+    public:
+        detached get_return_object() {
+            return detached();
+        }
+
+        std::suspend_never initial_suspend() {
+            return std::suspend_never();
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return std::suspend_never();
+        }
+
+        void return_void() { }
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+detached consume(sl::concurrent::async_queue<std::string>& queue, std::vector<std::string>& out) {
+    for (;;) {
+        std::optional<std::string> el = co_await queue.async_take();
+        if (!el) {
+            break;
+        }
+        out.push_back(std::move(*el));
+    }
+    out.push_back("done");
+}
+
+detached produce(sl::concurrent::async_queue<int>& queue, int from, int to, std::atomic<int>& finished) {
+    for (int i = from; i < to; i++) {
+        bool ok = co_await queue.async_put(i);
+        slassert(ok);
+    }
+    finished.fetch_add(1);
+}
+
+void test_take() {
+    sl::concurrent::async_queue<std::string> queue;
+    std::vector<std::string> out;
+    slassert(queue.emplace("foo"));
+    // takes available element without suspension
+    consume(queue, out);
+    slassert(1 == out.size());
+    slassert("foo" == out[0]);
+    // suspended consumer is resumed inline
+    slassert(queue.emplace("bar"));
+    slassert(2 == out.size());
+    slassert("bar" == out[1]);
+    slassert(queue.empty());
+    queue.unblock();
+    slassert(3 == out.size());
+    slassert("done" == out[2]);
+}
+
+class non_negative {
+public:
+    int value;
+
+    explicit non_negative(int value) :
+    value(value) {
+        if (value < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+detached consume_one(sl::concurrent::async_queue<non_negative>& queue, int& out) {
+    std::optional<non_negative> el = co_await queue.async_take();
+    out = el ? el->value : -1;
+}
+
+void test_throwing_emplace() {
+    sl::concurrent::async_queue<non_negative> queue;
+    int out = 0;
+    consume_one(queue, out);
+    bool thrown = false;
+    try {
+        queue.emplace(-1);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // suspended consumer is not lost
+    slassert(0 == out);
+    slassert(queue.emplace(42));
+    slassert(42 == out);
+    slassert(queue.empty());
+}
+
+void test_put() {
+    sl::concurrent::async_queue<int> queue{2};
+    std::atomic<int> finished{0};
+    produce(queue, 0, 5, finished);
+    slassert(0 == finished.load());
+    slassert(2 == queue.size());
+    int el = -1;
+    for (int i = 0; i < 5; i++) {
+        slassert(queue.poll(el));
+        slassert(i == el);
+    }
+    slassert(1 == finished.load());
+    slassert(!queue.poll(el));
+}
+
+void test_multiplexing() {
+    // thousands of logical consumers on a single thread
+    const size_t consumers_count = 2000;
+    sl::concurrent::async_queue<std::string> queue;
+    std::vector<std::vector<std::string>> outs(consumers_count);
+    for (size_t i = 0; i < consumers_count; i++) {
+        consume(queue, outs[i]);
+    }
+    for (size_t i = 0; i < consumers_count * 2; i++) {
+        slassert(queue.emplace("msg"));
+    }
+    queue.unblock();
+    for (auto& out : outs) {
+        // FIFO order of suspended consumers
+        slassert(3 == out.size());
+        slassert("done" == out.back());
+    }
+}
+
+detached sum_on_executor(sl::concurrent::async_queue<int>& queue, sl::concurrent::thread_pool_executor& executor,
+        std::atomic<long>& sum, sl::concurrent::countdown_latch& latch) {
+    for (;;) {
+        std::optional<int> el = co_await queue.async_take(executor);
+        if (!el) {
+            break;
+        }
+        sum.fetch_add(*el);
+    }
+    latch.count_down();
+}
+
+void test_executor() {
+    const int count = 5000;
+    sl::concurrent::async_queue<int> queue{16};
+    sl::concurrent::thread_pool_executor executor{2};
+    std::atomic<long> sum{0};
+    sl::concurrent::countdown_latch latch{4};
+    for (size_t i = 0; i < 4; i++) {
+        sum_on_executor(queue, executor, sum, latch);
+    }
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 2; i++) {
+        producers.emplace_back([&queue, &finished, i] {
+            produce(queue, i * count, (i + 1) * count, finished);
+        });
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    while (2 != finished.load() || !queue.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.unblock();
+    latch.await();
+    long expected = static_cast<long> (2 * count) * (2 * count - 1) / 2;
+    slassert(expected == sum.load());
+}
+
+class throwing_executor {
+public:
+    template<typename Func>
+    bool execute(Func&&) {
+        throw std::bad_alloc();
+    }
+};
+
+detached take_on_executor(sl::concurrent::async_queue<std::string>& queue, throwing_executor& executor,
+        std::vector<std::string>& out) {
+    for (;;) {
+        std::optional<std::string> el = co_await queue.async_take(executor);
+        if (!el) {
+            break;
+        }
+        out.push_back(std::move(*el));
+    }
+    out.push_back("done");
+}
+
+void test_throwing_executor() {
+    sl::concurrent::async_queue<std::string> queue;
+    throwing_executor executor;
+    std::vector<std::string> out1;
+    std::vector<std::string> out2;
+    take_on_executor(queue, executor, out1);
+    take_on_executor(queue, executor, out2);
+    // failed executor resumes inline, no coroutines are lost
+    slassert(queue.emplace("foo"));
+    slassert(queue.emplace("bar"));
+    slassert(1 == out1.size());
+    slassert("foo" == out1[0]);
+    slassert(1 == out2.size());
+    slassert("bar" == out2[0]);
+    queue.unblock();
+    slassert(2 == out1.size());
+    slassert("done" == out1.back());
+    slassert(2 == out2.size());
+    slassert("done" == out2.back());
+}
+
+int main() {
+    try {
+        test_take();
+        test_throwing_emplace();
+        test_put();
+        test_multiplexing();
+        test_executor();
+        test_throwing_executor();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#else // !__cpp_impl_coroutine
+
+int main() {
+    std::cout << "Coroutines are not supported, test skipped" << std::endl;
+    return 0;
+}
+
+#endif // __cpp_impl_coroutine
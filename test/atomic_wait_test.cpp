@@ -0,0 +1,82 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   atomic_wait_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:40 PM
+ */
+
+#include "staticlib/concurrent/atomic_wait.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_wait_notify() {
+    std::atomic<uint32_t> flag{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&flag] {
+            sl::concurrent::atomic_wait(flag, static_cast<uint32_t>(0));
+            slassert(1 == flag.load());
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    flag.store(1);
+    sl::concurrent::atomic_notify_all(flag);
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+void test_wait_64() {
+    std::atomic<int64_t> val{1LL << 40};
+    auto th = std::thread([&val] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        val.fetch_add(1);
+        sl::concurrent::atomic_notify_one(val);
+    });
+    sl::concurrent::atomic_wait(val, static_cast<int64_t>(1LL << 40));
+    slassert((1LL << 40) + 1 == val.load());
+    th.join();
+}
+
+void test_wait_until() {
+    std::atomic<uint32_t> flag{0};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    slassert(!sl::concurrent::atomic_wait_until(flag, static_cast<uint32_t>(0), deadline));
+    slassert(std::chrono::steady_clock::now() >= deadline);
+    flag.store(1);
+    slassert(sl::concurrent::atomic_wait_until(flag, static_cast<uint32_t>(0), deadline));
+}
+
+int main() {
+    try {
+        test_wait_notify();
+        test_wait_64();
+        test_wait_until();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
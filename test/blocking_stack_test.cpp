@@ -0,0 +1,135 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   blocking_stack_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:20 PM
+ */
+
+#include "staticlib/concurrent/blocking_stack.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+const size_t THREADS = 4;
+const size_t ITERATIONS = 100000;
+
+void test_lifo() {
+    sl::concurrent::blocking_stack<std::string> stack{3};
+    slassert(3 == stack.max_size());
+    slassert(stack.empty());
+    slassert(stack.emplace("foo"));
+    slassert(stack.emplace("bar"));
+    slassert(stack.emplace(3, 'a'));
+    slassert(!stack.emplace("baz"));
+    slassert(3 == stack.size());
+    std::string el;
+    slassert(stack.poll(el));
+    slassert("aaa" == el);
+    slassert(stack.poll(el));
+    slassert("bar" == el);
+    slassert(stack.emplace("baz"));
+    slassert(stack.poll(el));
+    slassert("baz" == el);
+    slassert(stack.poll(el));
+    slassert("foo" == el);
+    slassert(!stack.poll(el));
+    slassert(stack.empty());
+}
+
+void test_destructor() {
+    auto ptr = std::make_shared<int>(42);
+    {
+        sl::concurrent::blocking_stack<std::shared_ptr<int>> stack{4};
+        stack.emplace(ptr);
+        stack.emplace(ptr);
+        slassert(3 == ptr.use_count());
+    }
+    slassert(1 == ptr.use_count());
+}
+
+void test_take() {
+    sl::concurrent::blocking_stack<int> stack{4};
+    int el = 0;
+    slassert(!stack.take(el, std::chrono::milliseconds(50)));
+    std::thread producer([&stack] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stack.emplace(42);
+    });
+    slassert(stack.take(el));
+    slassert(42 == el);
+    producer.join();
+    std::thread consumer([&stack] {
+        int res = 0;
+        slassert(!stack.take(res));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stack.unblock();
+    consumer.join();
+    slassert(stack.is_unblocked());
+}
+
+void test_contention() {
+    sl::concurrent::blocking_stack<size_t> stack{64};
+    std::atomic<size_t> sum{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS; i++) {
+        threads.emplace_back([&stack] {
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                while (!stack.emplace(j)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&stack, &sum] {
+            size_t local = 0;
+            size_t el = 0;
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                slassert(stack.take(el));
+                local += el;
+            }
+            sum.fetch_add(local);
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(THREADS * (ITERATIONS * (ITERATIONS - 1) / 2) == sum.load());
+    slassert(stack.empty());
+    slassert(0 == stack.size());
+}
+
+int main() {
+    try {
+        test_lifo();
+        test_destructor();
+        test_take();
+        test_contention();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   channel_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#include "staticlib/concurrent/channel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+void test_buffered() {
+    sl::concurrent::channel<std::string> ch{2};
+    slassert(2 == ch.capacity());
+    slassert(ch.try_send("foo"));
+    slassert(ch.send("bar"));
+    slassert(!ch.try_send("baz"));
+    slassert(!ch.send("baz", std::chrono::milliseconds(50)));
+    slassert(2 == ch.size());
+    std::string el;
+    slassert(ch.recv(el));
+    slassert("foo" == el);
+    slassert(ch.close());
+    slassert(!ch.close());
+    slassert(ch.is_closed());
+    slassert(!ch.send("baz"));
+    // buffered values are delivered after close
+    slassert(ch.try_recv(el));
+    slassert("bar" == el);
+    slassert(!ch.recv(el));
+}
+
+void test_rendezvous() {
+    sl::concurrent::channel<std::unique_ptr<int>> ch;
+    slassert(!ch.try_send(std::unique_ptr<int>(new int(1))));
+    std::unique_ptr<int> el;
+    slassert(!ch.recv(el, std::chrono::milliseconds(50)));
+    std::atomic<bool> sent{false};
+    std::thread sender([&ch, &sent] {
+        slassert(ch.send(std::unique_ptr<int>(new int(42))));
+        sent.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // sender waits for the receiver
+    slassert(!sent.load());
+    slassert(ch.recv(el));
+    slassert(42 == *el);
+    sender.join();
+    slassert(sent.load());
+    slassert(0 == ch.size());
+}
+
+void test_close_wakes() {
+    sl::concurrent::channel<int> empty;
+    sl::concurrent::channel<int> full{1};
+    slassert(full.send(1));
+    std::thread receiver([&empty] {
+        int el = 0;
+        slassert(!empty.recv(el));
+    });
+    std::thread sender([&full] {
+        slassert(!full.send(2));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    empty.close();
+    full.close();
+    receiver.join();
+    sender.join();
+}
+
+void test_select() {
+    sl::concurrent::channel<int> ints{1};
+    sl::concurrent::channel<std::string> strings;
+    int num = 0;
+    std::string str;
+    sl::concurrent::selector sel;
+    size_t ints_idx = sel.recv(ints, num);
+    size_t strings_idx = sel.recv(strings, str);
+    slassert(2 == sel.size());
+    slassert(sl::concurrent::selector::timeout_index == sel.try_select());
+    slassert(sl::concurrent::selector::timeout_index == sel.select(std::chrono::milliseconds(50)));
+    slassert(ints.send(42));
+    slassert(ints_idx == sel.select());
+    slassert(sel.succeeded());
+    slassert(42 == num);
+    std::thread sender([&strings] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        slassert(strings.send("foo"));
+    });
+    slassert(strings_idx == sel.select());
+    slassert("foo" == str);
+    sender.join();
+    // stale registrations are dropped, next values go to plain receivers
+    slassert(ints.send(1));
+    slassert(ints.recv(num));
+    slassert(1 == num);
+    strings.close();
+    slassert(strings_idx == sel.select());
+    slassert(!sel.succeeded());
+}
+
+void test_select_send() {
+    sl::concurrent::channel<int> out;
+    sl::concurrent::channel<int> quit;
+    int dummy = 0;
+    sl::concurrent::selector sel;
+    size_t send_idx = sel.send(out, 42);
+    size_t quit_idx = sel.recv(quit, dummy);
+    std::thread receiver([&out] {
+        int el = 0;
+        slassert(out.recv(el));
+        slassert(42 == el);
+    });
+    slassert(send_idx == sel.select());
+    slassert(sel.succeeded());
+    receiver.join();
+    std::thread quitter([&quit] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        quit.close();
+    });
+    slassert(quit_idx == sel.select());
+    quitter.join();
+}
+
+void test_select_send_once() {
+    sl::concurrent::channel<std::string> out{2};
+    sl::concurrent::channel<std::unique_ptr<int>> ptrs{1};
+    sl::concurrent::selector sel;
+    size_t str_idx = sel.send(out, std::string("foo"));
+    size_t ptr_idx = sel.send(ptrs, std::unique_ptr<int>(new int(42)));
+    size_t first = sel.select();
+    slassert(sel.succeeded());
+    size_t second = sel.select();
+    slassert(sel.succeeded());
+    slassert(first != second);
+    slassert(str_idx == first || str_idx == second);
+    slassert(ptr_idx == first || ptr_idx == second);
+    // both values are sent exactly once, moved-from values are never sent
+    slassert(sl::concurrent::selector::timeout_index == sel.try_select());
+    slassert(sl::concurrent::selector::timeout_index == sel.select());
+    slassert(1 == out.size());
+    std::string str;
+    slassert(out.recv(str));
+    slassert("foo" == str);
+    std::unique_ptr<int> ptr;
+    slassert(ptrs.recv(ptr));
+    slassert(nullptr != ptr.get());
+    slassert(42 == *ptr);
+}
+
+void test_fan_in() {
+    const int per_producer = 2000;
+    const size_t producers_count = 4;
+    std::vector<std::unique_ptr<sl::concurrent::channel<int>>> channels;
+    for (size_t i = 0; i < producers_count; i++) {
+        channels.emplace_back(new sl::concurrent::channel<int>(i % 2));
+    }
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producers_count; i++) {
+        sl::concurrent::channel<int>& ch = *channels[i];
+        producers.emplace_back([&ch] {
+            for (int j = 1; j <= per_producer; j++) {
+                slassert(ch.send(j));
+            }
+            ch.close();
+        });
+    }
+    std::vector<int> values(producers_count);
+    std::vector<int> last(producers_count);
+    sl::concurrent::selector sel;
+    for (size_t i = 0; i < producers_count; i++) {
+        sel.recv(*channels[i], values[i]);
+    }
+    size_t closed = 0;
+    size_t received = 0;
+    while (closed < producers_count) {
+        size_t idx = sel.select();
+        slassert(idx < producers_count);
+        if (sel.succeeded()) {
+            // values from each channel are received in order
+            slassert(last[idx] + 1 == values[idx]);
+            last[idx] = values[idx];
+            received += 1;
+        } else if (last[idx] == per_producer) {
+            // closed channel stays ready, count it once
+            last[idx] += 1;
+            closed += 1;
+        }
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    slassert(producers_count * per_producer == received);
+}
+
+void test_competing_selects() {
+    const int count = 5000;
+    sl::concurrent::channel<int> ch;
+    std::atomic<int> sum{0};
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < 3; i++) {
+        consumers.emplace_back([&ch, &sum] {
+            sl::concurrent::channel<int> never;
+            int el = 0;
+            int dummy = 0;
+            sl::concurrent::selector sel;
+            size_t idx = sel.recv(ch, el);
+            sel.recv(never, dummy);
+            for (;;) {
+                size_t res = sel.select(std::chrono::milliseconds(1));
+                if (sl::concurrent::selector::timeout_index == res) {
+                    continue;
+                }
+                slassert(idx == res);
+                if (!sel.succeeded()) {
+                    break;
+                }
+                sum.fetch_add(el);
+            }
+        });
+    }
+    for (int i = 1; i <= count; i++) {
+        slassert(ch.send(i));
+    }
+    ch.close();
+    for (auto& th : consumers) {
+        th.join();
+    }
+    slassert(count * (count + 1) / 2 == sum.load());
+}
+
+int main() {
+    try {
+        test_buffered();
+        test_rendezvous();
+        test_close_wakes();
+        test_select();
+        test_select_send();
+        test_select_send_once();
+        test_fan_in();
+        test_competing_selects();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   combining_blocking_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 1:30 AM
+ */
+
+#include "staticlib/concurrent/combining_blocking_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_single_thread() {
+    sl::concurrent::combining_blocking_queue<std::string> queue;
+    slassert(queue.empty());
+    slassert(queue.emplace("foo"));
+    slassert(queue.emplace(3, 'b'));
+    slassert(2 == queue.size());
+    std::string el;
+    slassert(queue.poll(el));
+    slassert("foo" == el);
+    slassert(queue.take(el));
+    slassert("bbb" == el);
+    slassert(!queue.poll(el));
+    slassert(!queue.take(el, std::chrono::milliseconds(10)));
+}
+
+void test_bounded() {
+    sl::concurrent::combining_blocking_queue<int> queue{2};
+    slassert(queue.emplace(1));
+    slassert(queue.emplace(2));
+    slassert(queue.full());
+    slassert(!queue.emplace(3));
+    slassert(2 == queue.max_size());
+    std::vector<int> vec{3, 4};
+    slassert(0 == queue.emplace_range(vec));
+    size_t count = queue.poll([](int) { });
+    slassert(2 == count);
+    slassert(2 == queue.emplace_range(std::move(vec)));
+}
+
+void test_unblock() {
+    sl::concurrent::combining_blocking_queue<int> queue;
+    std::thread consumer([&queue] {
+        int el = 0;
+        slassert(!queue.take(el));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.unblock();
+    consumer.join();
+    slassert(queue.is_unblocked());
+}
+
+void test_take_wait() {
+    sl::concurrent::combining_blocking_queue<int> queue;
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.emplace(42);
+    });
+    int el = 0;
+    slassert(queue.take(el));
+    slassert(42 == el);
+    producer.join();
+}
+
+void test_concurrent() {
+    // few slots to exercise direct locking path
+    for (size_t slots : {2, 0}) {
+        sl::concurrent::combining_blocking_queue<std::unique_ptr<size_t>> queue{0, slots};
+        const size_t producers = 4;
+        const size_t per_producer = 20000;
+        std::atomic<size_t> sum{0};
+        std::atomic<size_t> taken{0};
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < producers; i++) {
+            threads.emplace_back([&queue, per_producer] {
+                for (size_t j = 0; j < per_producer; j++) {
+                    slassert(queue.emplace(new size_t(j)));
+                }
+            });
+        }
+        for (size_t i = 0; i < 4; i++) {
+            threads.emplace_back([&queue, &sum, &taken] {
+                std::unique_ptr<size_t> el;
+                while (queue.take(el)) {
+                    sum.fetch_add(*el);
+                    taken.fetch_add(1);
+                }
+            });
+        }
+        for (size_t i = 0; i < producers; i++) {
+            threads[i].join();
+        }
+        while (taken.load() < producers * per_producer) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        queue.unblock();
+        for (size_t i = producers; i < threads.size(); i++) {
+            threads[i].join();
+        }
+        slassert(producers * (per_producer * (per_producer - 1) / 2) == sum.load());
+        slassert(queue.empty());
+    }
+}
+
+class throwing_move {
+public:
+    bool fail;
+
+    explicit throwing_move(bool fail) :
+    fail(fail) { }
+
+    throwing_move(throwing_move&& other) :
+    fail(other.fail) {
+        if (fail) {
+            throw std::runtime_error("move failed");
+        }
+    }
+
+    throwing_move& operator=(throwing_move&& other) {
+        fail = other.fail;
+        return *this;
+    }
+};
+
+void test_exception() {
+    sl::concurrent::combining_blocking_queue<throwing_move> queue;
+    bool thrown = false;
+    try {
+        queue.emplace(true);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(queue.emplace(false));
+    slassert(1 == queue.size());
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_bounded();
+        test_unblock();
+        test_take_wait();
+        test_concurrent();
+        test_exception();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
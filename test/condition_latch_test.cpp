@@ -27,6 +27,7 @@
 #include <iostream>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 
@@ -47,9 +48,82 @@ void test_latch() {
     th.join();
 }
 
+class flag_check {
+    std::atomic<bool>& flag;
+
+public:
+    explicit flag_check(std::atomic<bool>& flag) :
+    flag(flag) { }
+
+    bool operator()() const {
+        return flag.load(std::memory_order_acquire);
+    }
+};
+
+void test_template_latch() {
+    std::atomic<bool> flag{false};
+    sl::concurrent::basic_condition_latch<flag_check> latch{flag_check(flag)};
+    slassert(!latch.await(std::chrono::milliseconds(10)));
+    slassert(!latch.await_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+    flag.store(true, std::memory_order_release);
+    latch.notify_all();
+    slassert(latch.await(std::chrono::milliseconds(10)));
+    latch.await();
+}
+
+void test_make_latch() {
+    std::atomic<size_t> count{0};
+    auto latch = sl::concurrent::make_condition_latch([&count] {
+        return count.load(std::memory_order_acquire) >= 4;
+    });
+    std::vector<std::thread> waiters;
+    for (size_t i = 0; i < 3; i++) {
+        waiters.emplace_back([&latch] {
+            slassert(latch->await_until(std::chrono::steady_clock::now() + std::chrono::seconds(10)));
+        });
+    }
+    for (size_t i = 0; i < 4; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        count.fetch_add(1, std::memory_order_release);
+        latch->notify_all();
+    }
+    for (auto& th : waiters) {
+        th.join();
+    }
+}
+
+void test_no_lost_wakeups() {
+    // ping-pong without timeouts, missed notification would hang
+    std::atomic<size_t> turn{0};
+    const size_t rounds = 20000;
+    auto even = sl::concurrent::make_condition_latch([&turn] {
+        return 0 == turn.load(std::memory_order_acquire) % 2;
+    });
+    auto odd = sl::concurrent::make_condition_latch([&turn] {
+        return 1 == turn.load(std::memory_order_acquire) % 2;
+    });
+    std::thread th([&turn, &even, &odd, rounds] {
+        for (size_t i = 0; i < rounds; i++) {
+            odd->await();
+            turn.fetch_add(1, std::memory_order_acq_rel);
+            even->notify_one();
+        }
+    });
+    for (size_t i = 0; i < rounds; i++) {
+        even->await();
+        turn.fetch_add(1, std::memory_order_acq_rel);
+        odd->notify_one();
+    }
+    th.join();
+    slassert(2 * rounds == turn.load());
+}
+
 int main() {
     try {
         test_latch();
+        test_template_latch();
+        test_make_latch();
+        test_no_lost_wakeups();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   conflating_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:05 AM
+ */
+
+#include "staticlib/concurrent/conflating_queue.hpp"
+
+#include "staticlib/concurrent/spin_mutex.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+void test_conflate() {
+    sl::concurrent::conflating_queue<std::string, int> queue;
+    slassert(queue.emplace("foo", 1));
+    slassert(queue.emplace("bar", 2));
+    slassert(queue.emplace("foo", 3));
+    slassert(queue.emplace("baz", 4));
+    slassert(queue.emplace("bar", 5));
+    slassert(3 == queue.size());
+    slassert(2 == queue.conflated_count());
+    slassert(queue.contains("foo"));
+    std::pair<std::string, int> el;
+    // original positions are kept, values are the latest ones
+    slassert(queue.poll(el));
+    slassert("foo" == el.first);
+    slassert(3 == el.second);
+    slassert(!queue.contains("foo"));
+    slassert(queue.take(el));
+    slassert("bar" == el.first);
+    slassert(5 == el.second);
+    // consumed key is queued again at the end
+    slassert(queue.emplace("foo", 6));
+    std::vector<std::pair<std::string, int>> drained;
+    slassert(2 == queue.poll([&drained](std::pair<std::string, int> en) {
+        drained.emplace_back(std::move(en));
+    }));
+    slassert("baz" == drained[0].first);
+    slassert(4 == drained[0].second);
+    slassert("foo" == drained[1].first);
+    slassert(6 == drained[1].second);
+    slassert(queue.empty());
+    slassert(!queue.poll(el));
+}
+
+void test_bounded() {
+    sl::concurrent::conflating_queue<int, std::string> queue{2};
+    slassert(2 == queue.max_size());
+    slassert(queue.emplace(1, "a"));
+    slassert(queue.emplace(2, "b"));
+    slassert(queue.full());
+    slassert(!queue.emplace(3, "c"));
+    // updates of queued keys are accepted
+    slassert(queue.emplace(1, 3, 'x'));
+    std::pair<int, std::string> el;
+    slassert(queue.poll(el));
+    slassert(1 == el.first);
+    slassert("xxx" == el.second);
+    slassert(queue.emplace(3, "c"));
+}
+
+void test_take_wait() {
+    sl::concurrent::conflating_queue<int, int> queue;
+    std::pair<int, int> el;
+    auto start = std::chrono::system_clock::now();
+    slassert(!queue.take(el, std::chrono::milliseconds(100)));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+    slassert(elapsed.count() >= 100);
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.emplace(1, 42);
+    });
+    slassert(queue.take(el));
+    slassert(42 == el.second);
+    producer.join();
+    std::thread unblocker([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.unblock();
+    });
+    slassert(!queue.take(el));
+    slassert(queue.is_unblocked());
+    unblocker.join();
+}
+
+void test_concurrent() {
+    const int keys = 16;
+    const int updates = 20000;
+    sl::concurrent::conflating_queue<int, int, std::hash<int>, std::equal_to<int>, sl::concurrent::spin_mutex> queue;
+    std::thread producer([&queue] {
+        for (int i = 1; i <= updates; i++) {
+            queue.emplace(i % keys, i);
+        }
+        queue.unblock();
+    });
+    std::map<int, int> last;
+    size_t taken = 0;
+    std::pair<int, int> el;
+    while (queue.take(el)) {
+        // values for each key are never observed out of order
+        slassert(el.second > last[el.first]);
+        slassert(el.first == el.second % keys);
+        last[el.first] = el.second;
+        taken += 1;
+    }
+    producer.join();
+    while (queue.poll(el)) {
+        slassert(el.second > last[el.first]);
+        last[el.first] = el.second;
+        taken += 1;
+    }
+    for (int k = 0; k < keys; k++) {
+        slassert(updates - keys < last[k]);
+    }
+    slassert(updates == static_cast<int> (taken + queue.conflated_count()));
+}
+
+class non_negative {
+public:
+    int value = 0;
+
+    non_negative() { }
+
+    explicit non_negative(int value) :
+    value(value) {
+        if (value < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+};
+
+void test_throwing_emplace() {
+    sl::concurrent::conflating_queue<std::string, non_negative> queue;
+    bool thrown = false;
+    try {
+        queue.emplace("foo", -1);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // failed key is not left in the queue order
+    slassert(queue.empty());
+    slassert(!queue.contains("foo"));
+    slassert(queue.emplace("bar", 1));
+    slassert(queue.emplace("foo", 2));
+    slassert(2 == queue.size());
+    std::pair<std::string, non_negative> el;
+    slassert(queue.poll(el));
+    slassert("bar" == el.first);
+    slassert(queue.poll(el));
+    slassert("foo" == el.first);
+    slassert(2 == el.second.value);
+    slassert(!queue.poll(el));
+}
+
+int main() {
+    try {
+        test_conflate();
+        test_bounded();
+        test_take_wait();
+        test_concurrent();
+        test_throwing_emplace();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
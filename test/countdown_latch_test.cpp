@@ -26,7 +26,10 @@
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "staticlib/config/assert.hpp"
 
@@ -49,9 +52,99 @@ void test_latch() {
     th2.join();
 }
 
+void test_count_down_n() {
+    sl::concurrent::countdown_latch latch{5};
+    slassert(5 == latch.get_count());
+    slassert(2 == latch.count_down(3));
+    slassert(!latch.await(std::chrono::milliseconds(10)));
+    slassert(0 == latch.count_down(3));
+    slassert(0 == latch.get_count());
+    slassert(0 == latch.count_down());
+    slassert(latch.await(std::chrono::milliseconds(10)));
+    latch.await();
+}
+
+void test_reset() {
+    sl::concurrent::countdown_latch latch{1};
+    auto th = std::thread([&latch] {
+        latch.await();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    slassert(1 == latch.reset());
+    th.join();
+    slassert(0 == latch.reset(2));
+    slassert(2 == latch.get_count());
+    slassert(1 == latch.count_down());
+}
+
+void test_many_threads() {
+    const size_t threads_count = 64;
+    sl::concurrent::countdown_latch latch{threads_count};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; i++) {
+        threads.emplace_back([&latch] {
+            latch.count_down();
+            latch.await();
+        });
+    }
+    latch.await();
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(0 == latch.get_count());
+}
+
+void test_destroy_after_await() {
+    for (size_t i = 0; i < 1000; i++) {
+        // latch is destroyed by the waiter while the last
+        // 'count_down' call may still be in progress
+        auto latch = new sl::concurrent::countdown_latch(2);
+        auto th1 = std::thread([latch] {
+            latch->count_down();
+        });
+        auto th2 = std::thread([latch] {
+            latch->count_down();
+        });
+        latch->await();
+        delete latch;
+        th1.join();
+        th2.join();
+    }
+}
+
+void test_large_values() {
+    sl::concurrent::countdown_latch latch{3};
+    // huge decrement is not turned into increment
+    slassert(0 == latch.count_down(static_cast<size_t> (-1)));
+    slassert(0 == latch.get_count());
+    slassert(latch.await(std::chrono::milliseconds(0)));
+    if (sizeof (size_t) > 4) {
+        bool thrown = false;
+        try {
+            latch.reset(static_cast<size_t> (0xFFFFFFFF) + 1);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+    slassert(0 == latch.reset(0xFFFFFFFF));
+    // waiter wakes up on the transition to zero from the max value
+    std::thread waiter([&latch] {
+        latch.await();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    slassert(0 == latch.count_down(0xFFFFFFFF));
+    waiter.join();
+}
+
 int main() {
     try {
         test_latch();
+        test_count_down_n();
+        test_reset();
+        test_many_threads();
+        test_destroy_after_await();
+        test_large_values();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
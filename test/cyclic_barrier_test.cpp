@@ -0,0 +1,122 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cyclic_barrier_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:20 PM
+ */
+
+#include "staticlib/concurrent/cyclic_barrier.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+const size_t ITERATIONS = 1000;
+
+void run_barrier(size_t parties, size_t fan_in) {
+    std::atomic<size_t> arrived{0};
+    std::atomic<size_t> completions{0};
+    std::atomic<size_t> last_arrivals{0};
+    sl::concurrent::cyclic_barrier barrier{parties, [&completions] {
+        completions.fetch_add(1, std::memory_order_relaxed);
+    }, fan_in};
+    slassert(parties == barrier.parties());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < parties; i++) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                arrived.fetch_add(1, std::memory_order_relaxed);
+                if (barrier.arrive_and_wait(i)) {
+                    last_arrivals.fetch_add(1, std::memory_order_relaxed);
+                }
+                // everybody arrived in this cycle
+                slassert(arrived.load(std::memory_order_relaxed) >= (j + 1) * parties);
+                barrier.arrive_and_wait(i);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(ITERATIONS * parties == arrived.load());
+    slassert(ITERATIONS * 2 == completions.load());
+    slassert(ITERATIONS == last_arrivals.load());
+    slassert(ITERATIONS * 2 == barrier.generation());
+}
+
+void test_flat() {
+    run_barrier(3, 4);
+}
+
+void test_tree() {
+    run_barrier(64, 4);
+    run_barrier(13, 2);
+}
+
+void test_single() {
+    sl::concurrent::cyclic_barrier barrier{1};
+    slassert(barrier.arrive_and_wait(0));
+    slassert(barrier.arrive_and_wait(0));
+    slassert(2 == barrier.generation());
+}
+
+void test_throwing_completion() {
+    std::atomic<size_t> calls{0};
+    sl::concurrent::cyclic_barrier barrier{4, [&calls] {
+        if (0 == calls.fetch_add(1, std::memory_order_relaxed)) {
+            throw std::runtime_error("completion");
+        }
+    }};
+    std::atomic<size_t> thrown{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&barrier, &thrown, i] {
+            try {
+                barrier.arrive_and_wait(i);
+            } catch (const std::runtime_error&) {
+                thrown.fetch_add(1, std::memory_order_relaxed);
+            }
+            // barrier is usable after the failed completion
+            barrier.arrive_and_wait(i);
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(1 == thrown.load());
+    slassert(2 == calls.load());
+    slassert(2 == barrier.generation());
+}
+
+int main() {
+    try {
+        test_flat();
+        test_tree();
+        test_single();
+        test_throwing_completion();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dedup_blocking_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:30 AM
+ */
+
+#include "staticlib/concurrent/dedup_blocking_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+void test_dedup() {
+    sl::concurrent::dedup_blocking_queue<std::string> queue;
+    slassert(queue.emplace("foo"));
+    slassert(queue.emplace("bar"));
+    slassert(!queue.emplace("foo"));
+    slassert(2 == queue.size());
+    slassert(queue.contains("foo"));
+    std::string el;
+    slassert(queue.poll(el));
+    slassert("foo" == el);
+    // released on take
+    slassert(!queue.contains("foo"));
+    slassert(queue.emplace("foo"));
+    std::vector<std::string> drained;
+    slassert(2 == queue.poll([&drained](std::string st) {
+        drained.emplace_back(std::move(st));
+    }));
+    slassert("bar" == drained[0]);
+    slassert("foo" == drained[1]);
+    slassert(queue.empty());
+    slassert(!queue.poll(el));
+    slassert(!queue.done("foo"));
+}
+
+void test_in_progress() {
+    sl::concurrent::dedup_blocking_queue<int> queue{0, true};
+    slassert(queue.tracks_in_progress());
+    slassert(queue.emplace(1));
+    int el = 0;
+    slassert(queue.take(el));
+    slassert(1 == el);
+    slassert(queue.contains(1));
+    slassert(queue.empty());
+    // emplaced during processing, queued again once
+    slassert(queue.emplace(1));
+    slassert(!queue.emplace(1));
+    slassert(queue.empty());
+    slassert(queue.done(1));
+    slassert(1 == queue.size());
+    slassert(queue.take(el));
+    slassert(!queue.done(1));
+    slassert(!queue.contains(1));
+    slassert(queue.emplace(1));
+}
+
+void test_bounded() {
+    sl::concurrent::dedup_blocking_queue<int> queue{2};
+    slassert(queue.emplace(1));
+    slassert(queue.emplace(2));
+    slassert(queue.full());
+    slassert(!queue.emplace(3));
+    // rejected item is not remembered
+    slassert(!queue.contains(3));
+    int el = 0;
+    slassert(queue.poll(el));
+    slassert(queue.emplace(3));
+}
+
+void test_take_wait() {
+    sl::concurrent::dedup_blocking_queue<int> queue;
+    int el = 0;
+    auto start = std::chrono::system_clock::now();
+    slassert(!queue.take(el, std::chrono::milliseconds(100)));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+    slassert(elapsed.count() >= 100);
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.emplace(42);
+    });
+    slassert(queue.take(el));
+    slassert(42 == el);
+    producer.join();
+    std::thread unblocker([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.unblock();
+    });
+    slassert(!queue.take(el));
+    slassert(queue.is_unblocked());
+    unblocker.join();
+}
+
+void test_concurrent() {
+    const int keys = 32;
+    sl::concurrent::dedup_blocking_queue<int> queue{0, true};
+    std::vector<std::atomic<int>> running(keys);
+    for (auto& en : running) {
+        en.store(0);
+    }
+    std::atomic<size_t> processed{0};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < 3; i++) {
+        workers.emplace_back([&queue, &running, &processed] {
+            int key = 0;
+            while (queue.take(key)) {
+                // the same key is never processed concurrently
+                slassert(1 == running[key].fetch_add(1) + 1);
+                std::this_thread::yield();
+                running[key].fetch_sub(1);
+                processed.fetch_add(1);
+                queue.done(key);
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < 2; i++) {
+        producers.emplace_back([&queue] {
+            for (int j = 0; j < 5000; j++) {
+                queue.emplace(j % keys);
+            }
+        });
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    for (int k = 0; k < keys; k++) {
+        while (queue.contains(k)) {
+            std::this_thread::yield();
+        }
+    }
+    queue.unblock();
+    for (auto& th : workers) {
+        th.join();
+    }
+    slassert(processed.load() >= static_cast<size_t> (keys));
+    slassert(processed.load() <= 10000);
+}
+
+void test_throwing_poll() {
+    sl::concurrent::dedup_blocking_queue<std::string> queue;
+    slassert(queue.emplace("foo"));
+    slassert(queue.emplace("bar"));
+    slassert(queue.emplace("baz"));
+    std::vector<std::string> consumed;
+    bool thrown = false;
+    try {
+        queue.poll([&consumed](std::string st) {
+            if ("bar" == st) {
+                throw std::runtime_error("bar");
+            }
+            consumed.emplace_back(std::move(st));
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(1 == consumed.size());
+    slassert("foo" == consumed[0]);
+    // failed item is released, the rest is queued again
+    slassert(!queue.contains("bar"));
+    slassert(queue.contains("baz"));
+    slassert(!queue.emplace("baz"));
+    slassert(queue.emplace("bar"));
+    const auto& cqueue = queue;
+    slassert(cqueue.contains("bar"));
+    std::string el;
+    slassert(queue.poll(el));
+    slassert("baz" == el);
+    slassert(queue.poll(el));
+    slassert("bar" == el);
+    slassert(queue.empty());
+}
+
+int main() {
+    try {
+        test_dedup();
+        test_in_progress();
+        test_bounded();
+        test_take_wait();
+        test_concurrent();
+        test_throwing_poll();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   delay_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:40 PM
+ */
+
+#include "staticlib/concurrent/delay_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_due_order() {
+    sl::concurrent::delay_queue<std::string> queue;
+    auto now = std::chrono::steady_clock::now();
+    queue.emplace(now + std::chrono::milliseconds(60), "baz");
+    queue.emplace(now + std::chrono::milliseconds(20), "foo");
+    queue.emplace(now + std::chrono::milliseconds(40), 3, 'b');
+    slassert(3 == queue.size());
+    std::string el;
+    slassert(!queue.poll(el));
+    slassert(queue.take(el));
+    slassert("foo" == el);
+    slassert(std::chrono::steady_clock::now() >= now + std::chrono::milliseconds(20));
+    slassert(queue.take(el));
+    slassert("bbb" == el);
+    slassert(std::chrono::steady_clock::now() >= now + std::chrono::milliseconds(40));
+    slassert(queue.take(el));
+    slassert("baz" == el);
+    slassert(std::chrono::steady_clock::now() >= now + std::chrono::milliseconds(60));
+    slassert(queue.empty());
+}
+
+void test_already_due() {
+    sl::concurrent::delay_queue<int> queue;
+    queue.emplace(std::chrono::steady_clock::now() - std::chrono::milliseconds(10), 42);
+    queue.emplace(std::chrono::milliseconds(0), 43);
+    int el = 0;
+    slassert(queue.poll(el));
+    slassert(42 == el);
+    // never taken before due time, may need to wait for the next tick
+    slassert(queue.take(el, std::chrono::milliseconds(100)));
+    slassert(43 == el);
+}
+
+void test_cancel() {
+    sl::concurrent::delay_queue<std::shared_ptr<int>> queue;
+    auto ptr = std::make_shared<int>(42);
+    auto id1 = queue.emplace(std::chrono::milliseconds(10), ptr);
+    auto id2 = queue.emplace(std::chrono::milliseconds(20), ptr);
+    slassert(0 != id1);
+    slassert(3 == ptr.use_count());
+    slassert(queue.cancel(id1));
+    slassert(!queue.cancel(id1));
+    slassert(2 == ptr.use_count());
+    slassert(1 == queue.size());
+    std::shared_ptr<int> el;
+    slassert(queue.take(el));
+    slassert(!queue.cancel(id2));
+    // reused node gets a new id
+    auto id3 = queue.emplace(std::chrono::milliseconds(10), ptr);
+    slassert(id3 != id1);
+    slassert(!queue.cancel(id1));
+    slassert(queue.cancel(id3));
+    slassert(queue.empty());
+}
+
+void test_long_delays() {
+    sl::concurrent::delay_queue<int> queue;
+    // upper wheel levels and overflow list
+    queue.emplace(std::chrono::milliseconds(300), 1);
+    queue.emplace(std::chrono::milliseconds(70000), 2);
+    queue.emplace(std::chrono::milliseconds(20000000), 3);
+    queue.emplace(std::chrono::hours(24 * 60), 4);
+    queue.emplace(std::chrono::milliseconds(280), 0);
+    int el = -1;
+    slassert(queue.take(el));
+    slassert(0 == el);
+    slassert(queue.take(el));
+    slassert(1 == el);
+    slassert(!queue.take(el, std::chrono::milliseconds(50)));
+    slassert(3 == queue.size());
+}
+
+void test_earlier_insert() {
+    sl::concurrent::delay_queue<int> queue;
+    queue.emplace(std::chrono::milliseconds(10000), 1);
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.emplace(std::chrono::milliseconds(10), 2);
+    });
+    auto start = std::chrono::steady_clock::now();
+    int el = 0;
+    slassert(queue.take(el));
+    slassert(2 == el);
+    slassert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(5000));
+    producer.join();
+}
+
+void test_unblock() {
+    sl::concurrent::delay_queue<int> queue;
+    queue.emplace(std::chrono::milliseconds(10000), 1);
+    std::thread consumer([&queue] {
+        int el = 0;
+        slassert(!queue.take(el));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.unblock();
+    consumer.join();
+    slassert(queue.is_unblocked());
+}
+
+void test_bounded() {
+    sl::concurrent::delay_queue<int> queue{2};
+    slassert(0 != queue.emplace(std::chrono::milliseconds(10), 1));
+    slassert(0 != queue.emplace(std::chrono::milliseconds(10), 2));
+    slassert(0 == queue.emplace(std::chrono::milliseconds(10), 3));
+    slassert(2 == queue.max_size());
+}
+
+void test_concurrent() {
+    sl::concurrent::delay_queue<size_t> queue;
+    const size_t producers = 4;
+    const size_t per_producer = 2000;
+    std::atomic<size_t> sum{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; i++) {
+        threads.emplace_back([&queue, i] {
+            for (size_t j = 0; j < per_producer; j++) {
+                queue.emplace(std::chrono::milliseconds((i * 7 + j) % 50), j);
+            }
+        });
+    }
+    for (size_t i = 0; i < 2; i++) {
+        threads.emplace_back([&queue, &sum] {
+            size_t el = 0;
+            while (queue.take(el)) {
+                sum.fetch_add(el);
+            }
+        });
+    }
+    for (size_t i = 0; i < producers; i++) {
+        threads[i].join();
+    }
+    while (!queue.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    queue.unblock();
+    for (size_t i = producers; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    slassert(producers * (per_producer * (per_producer - 1) / 2) == sum.load());
+}
+
+int main() {
+    try {
+        test_due_order();
+        test_already_due();
+        test_cancel();
+        test_long_delays();
+        test_earlier_insert();
+        test_unblock();
+        test_bounded();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   distributed_shared_mutex_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:10 AM
+ */
+
+#include "staticlib/concurrent/distributed_shared_mutex.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_try_lock() {
+    sl::concurrent::distributed_shared_mutex mutex;
+    slassert(mutex.try_lock_shared());
+    slassert(mutex.try_lock_shared());
+    slassert(!mutex.try_lock());
+    mutex.unlock_shared();
+    mutex.unlock_shared();
+    slassert(mutex.try_lock());
+    slassert(!mutex.try_lock_shared());
+    slassert(!mutex.try_lock());
+    mutex.unlock();
+    std::lock_guard<sl::concurrent::distributed_shared_mutex> guard{mutex};
+    slassert(!mutex.try_lock_shared());
+}
+
+void test_writer_waits_for_readers() {
+    sl::concurrent::distributed_shared_mutex mutex;
+    std::atomic<bool> reader_done{false};
+    mutex.lock_shared();
+    std::thread writer([&mutex, &reader_done] {
+        mutex.lock();
+        slassert(reader_done.load());
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reader_done.store(true);
+    mutex.unlock_shared();
+    writer.join();
+}
+
+void test_readers_wait_for_writer() {
+    sl::concurrent::distributed_shared_mutex mutex;
+    std::atomic<bool> writer_done{false};
+    mutex.lock();
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 4; i++) {
+        readers.emplace_back([&mutex, &writer_done] {
+            mutex.lock_shared();
+            slassert(writer_done.load());
+            mutex.unlock_shared();
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writer_done.store(true);
+    mutex.unlock();
+    for (auto& th : readers) {
+        th.join();
+    }
+}
+
+void test_concurrent() {
+    // writer keeps two values equal, readers must never see them differ
+    sl::concurrent::distributed_shared_mutex mutex{4};
+    size_t first = 0;
+    size_t second = 0;
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> reads{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 6; i++) {
+        threads.emplace_back([&mutex, &first, &second, &stop, &reads] {
+            while (!stop.load()) {
+                mutex.lock_shared();
+                slassert(first == second);
+                mutex.unlock_shared();
+                reads.fetch_add(1);
+            }
+        });
+    }
+    for (size_t i = 0; i < 2; i++) {
+        threads.emplace_back([&mutex, &first, &second] {
+            for (size_t j = 0; j < 200; j++) {
+                std::lock_guard<sl::concurrent::distributed_shared_mutex> guard{mutex};
+                first += 1;
+                std::this_thread::yield();
+                second += 1;
+            }
+        });
+    }
+    threads[6].join();
+    threads[7].join();
+    stop.store(true);
+    for (size_t i = 0; i < 6; i++) {
+        threads[i].join();
+    }
+    slassert(400 == first);
+    slassert(400 == second);
+    slassert(reads.load() > 0);
+}
+
+int main() {
+    try {
+        test_try_lock();
+        test_writer_waits_for_readers();
+        test_readers_wait_for_writer();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
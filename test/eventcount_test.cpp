@@ -0,0 +1,128 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   eventcount_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:20 PM
+ */
+
+#include "staticlib/concurrent/eventcount.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "staticlib/config/assert.hpp"
+
+void test_await() {
+    sl::concurrent::eventcount ec;
+    std::atomic<bool> flag{false};
+    auto th = std::thread([&ec, &flag] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        flag.store(true, std::memory_order_release);
+        ec.notify_all();
+    });
+    ec.await([&flag] {
+        return flag.load(std::memory_order_acquire);
+    });
+    slassert(flag.load(std::memory_order_acquire));
+    th.join();
+}
+
+void test_await_until() {
+    sl::concurrent::eventcount ec;
+    auto start = std::chrono::steady_clock::now();
+    bool res = ec.await_until([] {
+        return false;
+    }, start + std::chrono::milliseconds(100));
+    slassert(!res);
+    slassert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+}
+
+void test_ping_pong() {
+    sl::concurrent::eventcount ec;
+    std::atomic<size_t> counter{0};
+    const size_t limit = 10000;
+    auto th = std::thread([&ec, &counter, limit] {
+        for (size_t i = 1; i < limit; i += 2) {
+            ec.await([&counter, i] {
+                return i == counter.load(std::memory_order_acquire);
+            });
+            counter.store(i + 1, std::memory_order_release);
+            ec.notify_all();
+        }
+    });
+    for (size_t i = 0; i < limit; i += 2) {
+        ec.await([&counter, i] {
+            return i == counter.load(std::memory_order_acquire);
+        });
+        counter.store(i + 1, std::memory_order_release);
+        ec.notify_all();
+    }
+    th.join();
+    slassert(limit == counter.load(std::memory_order_acquire));
+}
+
+void test_condition() {
+    sl::concurrent::eventcount_condition cond;
+    std::mutex mutex;
+    size_t counter = 0;
+    const size_t limit = 10000;
+    auto th = std::thread([&cond, &mutex, &counter, limit] {
+        for (size_t i = 1; i < limit; i += 2) {
+            std::unique_lock<std::mutex> guard{mutex};
+            cond.wait(guard, [&counter, i] {
+                return i == counter;
+            });
+            counter += 1;
+            cond.notify_all();
+        }
+    });
+    for (size_t i = 0; i < limit; i += 2) {
+        std::unique_lock<std::mutex> guard{mutex};
+        cond.wait(guard, [&counter, i] {
+            return i == counter;
+        });
+        counter += 1;
+        cond.notify_one();
+    }
+    th.join();
+    slassert(limit == counter);
+    std::unique_lock<std::mutex> guard{mutex};
+    auto start = std::chrono::steady_clock::now();
+    slassert(!cond.wait_for(guard, std::chrono::milliseconds(100), [] {
+        return false;
+    }));
+    slassert(guard.owns_lock());
+    slassert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+}
+
+int main() {
+    try {
+        test_await();
+        test_await_until();
+        test_ping_pong();
+        test_condition();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fork_join_pool_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:47 PM
+ */
+
+#include "staticlib/concurrent/fork_join_pool.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "staticlib/concurrent/countdown_latch.hpp"
+#include "staticlib/config/assert.hpp"
+
+uint64_t fib(sl::concurrent::fork_join_pool& pool, uint64_t n) {
+    if (n < 10) {
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    uint64_t left = 0;
+    uint64_t right = 0;
+    sl::concurrent::fork_join_pool::task_group group{pool};
+    group.fork([&pool, &left, n] {
+        left = fib(pool, n - 1);
+    });
+    right = fib(pool, n - 2);
+    group.join();
+    return left + right;
+}
+
+void test_fork_join() {
+    sl::concurrent::fork_join_pool pool{4};
+    slassert(4 == pool.threads_count());
+    uint64_t res = 0;
+    sl::concurrent::fork_join_pool::task_group group{pool};
+    group.fork([&pool, &res] {
+        res = fib(pool, 25);
+    });
+    group.join();
+    slassert(75025 == res);
+}
+
+void test_submit() {
+    sl::concurrent::fork_join_pool pool{2};
+    auto latch = std::make_shared<sl::concurrent::countdown_latch>(100);
+    std::atomic<int> shared{0};
+    for (size_t i = 0; i < 100; i++) {
+        pool.submit([latch, &shared] {
+            shared.fetch_add(1, std::memory_order_relaxed);
+            latch->count_down();
+        });
+    }
+    latch->await();
+    slassert(100 == shared.load(std::memory_order_relaxed));
+}
+
+void test_exception() {
+    sl::concurrent::fork_join_pool pool{2};
+    sl::concurrent::fork_join_pool::task_group group{pool};
+    group.fork([] {
+        throw std::runtime_error("foo");
+    });
+    bool thrown = false;
+    try {
+        group.join();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_idle() {
+    sl::concurrent::fork_join_pool pool{2};
+    // let workers park
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::atomic<bool> flag{false};
+    sl::concurrent::fork_join_pool::task_group group{pool};
+    group.fork([&flag] {
+        flag.store(true, std::memory_order_release);
+    });
+    group.join();
+    slassert(flag.load(std::memory_order_acquire));
+}
+
+void test_discard() {
+    std::unique_ptr<sl::concurrent::fork_join_pool> pool{new sl::concurrent::fork_join_pool(1)};
+    sl::concurrent::countdown_latch started{1};
+    sl::concurrent::countdown_latch latch{1};
+    std::atomic<bool> second_run{false};
+    {
+        sl::concurrent::fork_join_pool::task_group group{*pool};
+        // occupies the only worker
+        group.fork([&started, &latch] {
+            started.count_down();
+            latch.await();
+        });
+        group.fork([&second_run] {
+            second_run.store(true, std::memory_order_release);
+        });
+        started.await();
+        std::thread releaser([&latch] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            latch.count_down();
+        });
+        pool.reset();
+        releaser.join();
+        // discarded task is completed, group destructor does not hang
+    }
+    slassert(!second_run.load(std::memory_order_acquire));
+}
+
+class throwing_copy {
+public:
+    throwing_copy() { }
+
+    throwing_copy(const throwing_copy&) {
+        throw std::runtime_error("copy");
+    }
+
+    void operator()() { }
+};
+
+void test_throwing_fork() {
+    sl::concurrent::fork_join_pool pool{2};
+    sl::concurrent::fork_join_pool::task_group group{pool};
+    throwing_copy func;
+    bool thrown = false;
+    try {
+        group.fork(func);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // failed fork is not counted as pending
+    group.join();
+}
+
+int main() {
+    try {
+        test_fork_join();
+        test_submit();
+        test_exception();
+        test_idle();
+        test_discard();
+        test_throwing_fork();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
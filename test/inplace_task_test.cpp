@@ -0,0 +1,152 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   inplace_task_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:55 PM
+ */
+
+#include "staticlib/concurrent/inplace_task.hpp"
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "staticlib/config/assert.hpp"
+
+class counting_functor {
+public:
+    static int alive;
+    int* target;
+
+    explicit counting_functor(int* target) :
+    target(target) {
+        alive += 1;
+    }
+
+    counting_functor(const counting_functor& other) :
+    target(other.target) {
+        alive += 1;
+    }
+
+    counting_functor(counting_functor&& other) :
+    target(other.target) {
+        alive += 1;
+    }
+
+    ~counting_functor() {
+        alive -= 1;
+    }
+
+    void operator()() {
+        *target += 1;
+    }
+};
+
+int counting_functor::alive = 0;
+
+class move_only_functor {
+public:
+    std::unique_ptr<std::string> ptr;
+    std::string* target;
+
+    move_only_functor(std::unique_ptr<std::string> ptr, std::string* target) :
+    ptr(std::move(ptr)),
+    target(target) { }
+
+    void operator()() {
+        *target = *ptr;
+    }
+};
+
+void test_inline() {
+    using task_type = sl::concurrent::inplace_task<>;
+    int counter = 0;
+    auto lambda = [&counter] {
+        counter += 1;
+    };
+    slassert(task_type::fits_inline<decltype(lambda)>::value);
+    task_type task{lambda};
+    slassert(static_cast<bool>(task));
+    task();
+    task();
+    slassert(2 == counter);
+    task.reset();
+    slassert(!task);
+}
+
+void test_move_only() {
+    auto ptr = std::unique_ptr<std::string>(new std::string("foo"));
+    std::string res;
+    sl::concurrent::inplace_task<> task{move_only_functor(std::move(ptr), &res)};
+    sl::concurrent::inplace_task<> moved{std::move(task)};
+    slassert(!task);
+    slassert(static_cast<bool>(moved));
+    moved();
+    slassert("foo" == res);
+}
+
+void test_heap_fallback() {
+    using task_type = sl::concurrent::inplace_task<16>;
+    std::array<char, 64> data;
+    data.fill('a');
+    size_t sum = 0;
+    auto lambda = [data, &sum] {
+        for (char ch : data) {
+            sum += static_cast<size_t>(ch);
+        }
+    };
+    slassert(!task_type::fits_inline<decltype(lambda)>::value);
+    task_type task{lambda};
+    task_type other;
+    other = std::move(task);
+    slassert(!task);
+    other();
+    slassert(64 * static_cast<size_t>('a') == sum);
+}
+
+void test_destruction() {
+    int counter = 0;
+    {
+        sl::concurrent::inplace_task<> task{counting_functor(&counter)};
+        slassert(1 == counting_functor::alive);
+        sl::concurrent::inplace_task<> moved{std::move(task)};
+        slassert(1 == counting_functor::alive);
+        moved();
+        moved.emplace(counting_functor(&counter));
+        slassert(1 == counting_functor::alive);
+        moved();
+    }
+    slassert(0 == counting_functor::alive);
+    slassert(2 == counter);
+}
+
+int main() {
+    try {
+        test_inline();
+        test_move_only();
+        test_heap_fallback();
+        test_destruction();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
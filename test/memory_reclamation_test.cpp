@@ -0,0 +1,293 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   memory_reclamation_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:00 AM
+ */
+
+#include "staticlib/concurrent/memory_reclamation.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+std::atomic<size_t> alive_count{0};
+
+class node {
+public:
+    size_t value;
+    node* next = nullptr;
+    // overwritten on destruction, use-after-free is detected by readers
+    size_t canary = 42;
+
+    explicit node(size_t value) :
+    value(value) {
+        alive_count.fetch_add(1);
+    }
+
+    ~node() {
+        canary = 0;
+        alive_count.fetch_sub(1);
+    }
+};
+
+class node_pool {
+public:
+    std::mutex mutex;
+    std::vector<node*> free_nodes;
+
+    ~node_pool() {
+        for (node* nd : free_nodes) {
+            delete nd;
+        }
+    }
+
+    static void give_back(void* ptr, void* ctx) {
+        node_pool* pool = static_cast<node_pool*> (ctx);
+        node* nd = static_cast<node*> (ptr);
+        nd->canary = 0;
+        std::lock_guard<std::mutex> guard{pool->mutex};
+        pool->free_nodes.push_back(nd);
+    }
+};
+
+// Treiber stack
+class stack {
+public:
+    std::atomic<node*> head{nullptr};
+
+    ~stack() {
+        node* nd = head.load();
+        while (nullptr != nd) {
+            node* next = nd->next;
+            delete nd;
+            nd = next;
+        }
+    }
+
+    void push(node* nd) {
+        node* next = head.load(std::memory_order_relaxed);
+        do {
+            nd->next = next;
+        } while (!head.compare_exchange_weak(next, nd, std::memory_order_release, std::memory_order_relaxed));
+    }
+};
+
+node* pop_epoch(stack& st, sl::concurrent::epoch_domain::participant& pt) {
+    auto guard = pt.pin();
+    node* nd = st.head.load(std::memory_order_acquire);
+    while (nullptr != nd) {
+        slassert(42 == nd->canary);
+        if (st.head.compare_exchange_weak(nd, nd->next, std::memory_order_acquire, std::memory_order_acquire)) {
+            break;
+        }
+    }
+    return nd;
+}
+
+node* pop_hazard(stack& st, sl::concurrent::hazard_domain::participant& pt) {
+    for (;;) {
+        node* nd = pt.protect(0, st.head);
+        if (nullptr == nd) {
+            return nullptr;
+        }
+        slassert(42 == nd->canary);
+        node* next = nd->next;
+        if (st.head.compare_exchange_strong(nd, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+            pt.clear(0);
+            return nd;
+        }
+    }
+}
+
+void test_epoch_single_thread() {
+    {
+        sl::concurrent::epoch_domain domain{4};
+        auto pt = domain.register_thread();
+        {
+            auto guard = pt.pin();
+            auto nested = pt.pin();
+            pt.retire(new node(1));
+            slassert(1 == pt.retired_count());
+        }
+        // epoch advanced on retire, node is reclaimed after the second advance
+        slassert(1 == pt.collect());
+        slassert(0 == pt.retired_count());
+        slassert(0 == alive_count.load());
+        {
+            auto guard = pt.pin();
+            uint64_t epoch = domain.epoch();
+            // pinned in the current epoch, so it can advance only once
+            for (size_t i = 0; i < 10; i++) {
+                pt.retire(new node(i));
+            }
+            slassert(epoch + 1 >= domain.epoch());
+        }
+        pt.retire(new node(42));
+    }
+    slassert(0 == alive_count.load());
+}
+
+void test_epoch_stalled() {
+    sl::concurrent::epoch_domain domain{8};
+    auto stalled = domain.register_thread();
+    auto pt = domain.register_thread();
+    {
+        auto guard = stalled.pin();
+        for (size_t i = 0; i < 100; i++) {
+            pt.retire(new node(i));
+        }
+        // stalled reader prevents reclamation
+        slassert(100 == pt.retired_count());
+    }
+    pt.collect();
+    pt.collect();
+    pt.collect();
+    slassert(0 == pt.retired_count());
+    slassert(0 == alive_count.load());
+}
+
+void test_epoch_concurrent() {
+    {
+        sl::concurrent::epoch_domain domain{16};
+        stack st;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; i++) {
+            threads.emplace_back([&domain, &st, i] {
+                auto pt = domain.register_thread();
+                for (size_t j = 0; j < 5000; j++) {
+                    st.push(new node(i * 10000 + j));
+                    node* nd = pop_epoch(st, pt);
+                    if (nullptr != nd) {
+                        pt.retire(nd);
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    slassert(0 == alive_count.load());
+}
+
+void test_hazard_single_thread() {
+    {
+        sl::concurrent::hazard_domain domain{1, 4};
+        auto pt = domain.register_thread();
+        auto other = domain.register_thread();
+        stack st;
+        st.push(new node(1));
+        node* protected_node = other.protect(0, st.head);
+        slassert(protected_node == pop_hazard(st, pt));
+        pt.retire(protected_node);
+        slassert(0 == pt.collect());
+        slassert(1 == pt.retired_count());
+        slassert(42 == protected_node->canary);
+        other.clear(0);
+        slassert(1 == pt.collect());
+        slassert(0 == alive_count.load());
+        // threshold grows with number of hazard slots
+        for (size_t i = 0; i < 3; i++) {
+            pt.retire(new node(i));
+        }
+        slassert(3 == pt.retired_count());
+        pt.retire(new node(3));
+        slassert(0 == pt.retired_count());
+    }
+    slassert(0 == alive_count.load());
+}
+
+void test_hazard_orphans() {
+    sl::concurrent::hazard_domain domain;
+    auto pt = domain.register_thread();
+    node* nd = new node(0);
+    pt.set(0, nd);
+    {
+        auto other = domain.register_thread();
+        other.retire(nd);
+    }
+    slassert(1 == alive_count.load());
+    pt.clear(0);
+    slassert(1 == pt.collect());
+    slassert(0 == alive_count.load());
+}
+
+void test_hazard_concurrent() {
+    {
+        node_pool pool;
+        sl::concurrent::hazard_domain domain{1, 16};
+        stack st;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; i++) {
+            threads.emplace_back([&domain, &st, &pool, i] {
+                auto pt = domain.register_thread();
+                for (size_t j = 0; j < 5000; j++) {
+                    st.push(new node(i * 10000 + j));
+                    node* nd = pop_hazard(st, pt);
+                    if (nullptr != nd) {
+                        pt.retire(nd, node_pool::give_back, std::addressof(pool));
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    slassert(0 == alive_count.load());
+}
+
+void test_register_reuse() {
+    sl::concurrent::epoch_domain domain;
+    for (size_t i = 0; i < 3; i++) {
+        std::thread th([&domain] {
+            auto pt = domain.register_thread();
+            auto guard = pt.pin();
+            pt.retire(new node(0));
+        });
+        th.join();
+    }
+    auto pt = domain.register_thread();
+    pt.collect();
+    pt.collect();
+    pt.collect();
+    slassert(0 == alive_count.load());
+}
+
+int main() {
+    try {
+        test_epoch_single_thread();
+        test_epoch_stalled();
+        test_epoch_concurrent();
+        test_hazard_single_thread();
+        test_hazard_orphans();
+        test_hazard_concurrent();
+        test_register_reuse();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -23,6 +23,11 @@
 
 #include "staticlib/concurrent/mpmc_blocking_queue.hpp"
 
+#include "staticlib/concurrent/mcs_mutex.hpp"
+#include "staticlib/concurrent/spin_mutex.hpp"
+#include "staticlib/concurrent/ticket_mutex.hpp"
+
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <thread>
@@ -334,6 +339,36 @@ void test_common() {
     test_wait<queue_maker<std::string, 1>> ();
 }
 
+template<typename Mutex>
+void test_custom_mutex() {
+    sl::concurrent::mpmc_blocking_queue<size_t, Mutex> queue{};
+    const size_t per_producer = 10000;
+    std::atomic<size_t> sum{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 3; i++) {
+        threads.emplace_back([&queue, per_producer] {
+            for (size_t j = 0; j < per_producer; j++) {
+                queue.emplace(j);
+            }
+        });
+    }
+    for (size_t i = 0; i < 3; i++) {
+        threads.emplace_back([&queue, &sum, per_producer] {
+            for (size_t j = 0; j < per_producer; j++) {
+                size_t el = 0;
+                slassert(queue.take(el));
+                sum.fetch_add(el);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(3 * (per_producer * (per_producer - 1) / 2) == sum.load());
+    size_t el = 0;
+    slassert(!queue.take(el, std::chrono::milliseconds(10)));
+}
+
 int main() {
     try {
         test_take();
@@ -347,6 +382,9 @@ int main() {
         test_emplace_range();
         test_poll_consume();
         test_common();
+        test_custom_mutex<sl::concurrent::spin_mutex>();
+        test_custom_mutex<sl::concurrent::ticket_mutex>();
+        test_custom_mutex<sl::concurrent::mcs_mutex>();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   phaser_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:35 PM
+ */
+
+#include "staticlib/concurrent/phaser.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+const size_t ITERATIONS = 500;
+
+void test_single_thread() {
+    sl::concurrent::phaser ph{2};
+    slassert(0 == ph.phase());
+    slassert(2 == ph.registered_parties());
+    slassert(0 == ph.arrive());
+    slassert(1 == ph.arrived_parties());
+    slassert(0 == ph.arrive());
+    slassert(1 == ph.phase());
+    slassert(2 == ph.unarrived_parties());
+    slassert(1 == ph.register_party());
+    slassert(3 == ph.registered_parties());
+    slassert(1 == ph.arrive_and_deregister());
+    slassert(2 == ph.registered_parties());
+    ph.arrive();
+    ph.arrive();
+    slassert(2 == ph.phase());
+    // returns immediately for past phase
+    slassert(2 == ph.await_phase(0));
+}
+
+void test_arrive_and_wait() {
+    const size_t parties = 8;
+    sl::concurrent::phaser ph{static_cast<uint32_t>(parties)};
+    std::atomic<size_t> arrived{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < parties; i++) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                arrived.fetch_add(1, std::memory_order_relaxed);
+                uint32_t next = ph.arrive_and_wait();
+                slassert(next == j + 1);
+                slassert(arrived.load(std::memory_order_relaxed) >= (j + 1) * parties);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(ITERATIONS == ph.phase());
+}
+
+void test_dynamic_parties() {
+    sl::concurrent::phaser ph{1};
+    std::atomic<size_t> done{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        ph.register_party();
+        threads.emplace_back([&ph, &done, i] {
+            for (size_t j = 0; j < i + 1; j++) {
+                ph.arrive_and_wait();
+            }
+            ph.arrive_and_deregister();
+            done.fetch_add(1);
+        });
+    }
+    // controller keeps advancing while workers leave
+    while (done.load() < 4) {
+        ph.arrive_and_wait();
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(1 == ph.registered_parties());
+}
+
+void test_await_phase() {
+    sl::concurrent::phaser ph{1};
+    auto th = std::thread([&ph] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ph.arrive();
+    });
+    slassert(1 == ph.await_phase(0));
+    th.join();
+}
+
+void test_tiered() {
+    const size_t children_count = 4;
+    const size_t per_child = 4;
+    sl::concurrent::phaser root;
+    std::vector<std::unique_ptr<sl::concurrent::phaser>> children;
+    for (size_t i = 0; i < children_count; i++) {
+        children.emplace_back(new sl::concurrent::phaser(root, static_cast<uint32_t>(per_child)));
+    }
+    slassert(children_count == root.registered_parties());
+    std::atomic<size_t> arrived{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < children_count; i++) {
+        for (size_t k = 0; k < per_child; k++) {
+            auto child = children[i].get();
+            threads.emplace_back([&arrived, child] {
+                for (size_t j = 0; j < ITERATIONS; j++) {
+                    arrived.fetch_add(1, std::memory_order_relaxed);
+                    uint32_t next = child->arrive_and_wait();
+                    slassert(next == j + 1);
+                    slassert(arrived.load(std::memory_order_relaxed) >= (j + 1) * children_count * per_child);
+                }
+                child->arrive_and_deregister();
+            });
+        }
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(0 == root.registered_parties());
+    slassert(ITERATIONS + 1 == root.phase());
+}
+
+void test_invalid_usage() {
+    sl::concurrent::phaser ph{1};
+    slassert(0 == ph.arrive());
+    // no parties left after deregistration
+    sl::concurrent::phaser single{1};
+    single.arrive_and_deregister();
+    bool thrown = false;
+    try {
+        single.arrive();
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(0 == single.registered_parties());
+    slassert(0 == single.unarrived_parties());
+
+    thrown = false;
+    try {
+        ph.bulk_register(0xFFFF);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(1 == ph.registered_parties());
+    slassert(1 == ph.bulk_register(65534));
+    slassert(65535 == ph.registered_parties());
+
+    thrown = false;
+    try {
+        sl::concurrent::phaser big{0x10000};
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_arrive_and_wait();
+        test_dynamic_parties();
+        test_await_phase();
+        test_tiered();
+        test_invalid_usage();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   priority_blocking_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:20 PM
+ */
+
+#include "staticlib/concurrent/priority_blocking_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+const size_t THREADS = 4;
+const size_t ITERATIONS = 50000;
+
+void test_order() {
+    sl::concurrent::priority_blocking_queue<int> queue{0, 1};
+    for (int el : {5, 1, 9, 3, 7}) {
+        slassert(queue.emplace(el));
+    }
+    slassert(5 == queue.size());
+    int el = 0;
+    std::vector<int> res;
+    while (queue.poll(el)) {
+        res.push_back(el);
+    }
+    slassert((std::vector<int>{9, 7, 5, 3, 1}) == res);
+    slassert(queue.empty());
+}
+
+void test_comparator() {
+    sl::concurrent::priority_blocking_queue<std::string, std::greater<std::string>> queue{0, 1};
+    queue.emplace("bbb");
+    queue.emplace(3, 'a');
+    queue.emplace("ccc");
+    std::string el;
+    slassert(queue.poll(el));
+    slassert("aaa" == el);
+    slassert(queue.poll(el));
+    slassert("bbb" == el);
+}
+
+void test_relaxed_order() {
+    sl::concurrent::priority_blocking_queue<int> queue{0, 4};
+    for (int i = 0; i < 1000; i++) {
+        queue.emplace(i);
+    }
+    // first taken elements come from the top of the heaps
+    int el = 0;
+    slassert(queue.poll(el));
+    slassert(el > 900);
+    size_t count = 1;
+    while (queue.poll(el)) {
+        count += 1;
+    }
+    slassert(1000 == count);
+}
+
+void test_bounded() {
+    sl::concurrent::priority_blocking_queue<int> queue{2};
+    slassert(2 == queue.max_size());
+    slassert(queue.emplace(1));
+    slassert(queue.emplace(2));
+    slassert(queue.full());
+    slassert(!queue.emplace(3));
+    int el = 0;
+    slassert(queue.poll(el));
+    slassert(!queue.full());
+}
+
+void test_take() {
+    sl::concurrent::priority_blocking_queue<int> queue;
+    int el = 0;
+    slassert(!queue.take(el, std::chrono::milliseconds(50)));
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.emplace(42);
+    });
+    slassert(queue.take(el));
+    slassert(42 == el);
+    producer.join();
+    std::thread consumer([&queue] {
+        int res = 0;
+        slassert(!queue.take(res));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.unblock();
+    consumer.join();
+    slassert(queue.is_unblocked());
+}
+
+void test_concurrent() {
+    sl::concurrent::priority_blocking_queue<size_t> queue;
+    std::atomic<size_t> sum{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS; i++) {
+        threads.emplace_back([&queue] {
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                queue.emplace(j);
+            }
+        });
+        threads.emplace_back([&queue, &sum] {
+            size_t local = 0;
+            size_t el = 0;
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                slassert(queue.take(el));
+                local += el;
+            }
+            sum.fetch_add(local);
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(THREADS * (ITERATIONS * (ITERATIONS - 1) / 2) == sum.load());
+    slassert(queue.empty());
+}
+
+int main() {
+    try {
+        test_order();
+        test_comparator();
+        test_relaxed_order();
+        test_bounded();
+        test_take();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
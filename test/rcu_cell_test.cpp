@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   rcu_cell_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:20 AM
+ */
+
+#include "staticlib/concurrent/rcu_cell.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+std::atomic<size_t> alive_count{0};
+
+class routes {
+public:
+    std::map<std::string, size_t> table;
+    size_t version;
+    // overwritten on destruction, use-after-free is detected by readers
+    size_t canary = 42;
+
+    explicit routes(size_t version) :
+    version(version) {
+        alive_count.fetch_add(1);
+        for (size_t i = 0; i < 16; i++) {
+            table["route_" + sl::support::to_string(i)] = version;
+        }
+    }
+
+    ~routes() {
+        canary = 0;
+        alive_count.fetch_sub(1);
+    }
+};
+
+void test_single_thread() {
+    {
+        sl::concurrent::rcu_cell<routes> cell{std::unique_ptr<routes>(new routes(1))};
+        {
+            auto snap = cell.read();
+            slassert(snap);
+            slassert(1 == snap->version);
+            slassert(1 == (*snap).table.at("route_3"));
+        }
+        cell.store(std::unique_ptr<routes>(new routes(2)));
+        slassert(0 == cell.retired_count());
+        slassert(1 == alive_count.load());
+        cell.update([](const routes* prev) {
+            return std::unique_ptr<routes>(new routes(prev->version + 1));
+        });
+        slassert(3 == cell.read()->version);
+    }
+    slassert(0 == alive_count.load());
+}
+
+void test_empty() {
+    sl::concurrent::rcu_cell<int> cell;
+    slassert(!cell.read());
+    cell.store(std::unique_ptr<int>(new int(42)));
+    slassert(42 == *cell.read());
+    cell.store(std::unique_ptr<int>());
+    slassert(nullptr == cell.read().get());
+}
+
+void test_batch() {
+    sl::concurrent::rcu_cell<routes> cell{std::unique_ptr<routes>(new routes(0)), 4};
+    auto snap = cell.read();
+    for (size_t i = 1; i <= 3; i++) {
+        cell.store(std::unique_ptr<routes>(new routes(i)));
+    }
+    slassert(3 == cell.retired_count());
+    slassert(4 == alive_count.load());
+    // pinned version is still alive
+    slassert(0 == snap->version);
+    slassert(42 == snap->canary);
+    std::thread reclaimer([&cell] {
+        slassert(3 == cell.reclaim());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // reclaimer waits for the grace period
+    slassert(4 == alive_count.load());
+    {
+        auto moved = std::move(snap);
+        slassert(0 == moved->version);
+    }
+    reclaimer.join();
+    slassert(1 == alive_count.load());
+    slassert(0 == cell.retired_count());
+}
+
+void test_concurrent() {
+    {
+        sl::concurrent::rcu_cell<routes> cell{std::unique_ptr<routes>(new routes(0)), 8};
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (size_t i = 0; i < 4; i++) {
+            readers.emplace_back([&cell, &stop] {
+                size_t last = 0;
+                while (!stop.load()) {
+                    auto snap = cell.read();
+                    slassert(42 == snap->canary);
+                    slassert(snap->version >= last);
+                    slassert(snap->version == snap->table.at("route_7"));
+                    last = snap->version;
+                    std::this_thread::yield();
+                    slassert(42 == snap->canary);
+                }
+            });
+        }
+        for (size_t i = 1; i <= 2000; i++) {
+            cell.update([](const routes* prev) {
+                return std::unique_ptr<routes>(new routes(prev->version + 1));
+            });
+        }
+        stop.store(true);
+        for (auto& th : readers) {
+            th.join();
+        }
+        slassert(2000 == cell.read()->version);
+    }
+    slassert(0 == alive_count.load());
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_empty();
+        test_batch();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
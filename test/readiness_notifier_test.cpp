@@ -0,0 +1,172 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   readiness_notifier_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 8:00 AM
+ */
+
+#include "staticlib/concurrent/readiness_notifier.hpp"
+
+#include <iostream>
+
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/concurrent/mpmc_blocking_queue.hpp"
+#include "staticlib/concurrent/spsc_waiting_queue.hpp"
+
+#ifdef __linux__
+
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+bool readable(int fd) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return 1 == ::poll(std::addressof(pfd), 1, 0);
+}
+
+void test_coalescing() {
+    sl::concurrent::mpmc_blocking_queue<std::string, std::mutex, sl::concurrent::eventfd_notifier> queue;
+    auto& nt = queue.notifier();
+    slassert(nt.fd() >= 0);
+    slassert(nt.is_armed());
+    slassert(!readable(nt.fd()));
+    slassert(!nt.reset());
+
+    // empty -> non-empty transition signals armed notifier
+    slassert(queue.emplace("foo"));
+    slassert(readable(nt.fd()));
+    slassert(!nt.is_armed());
+    // further emplaces are coalesced
+    slassert(queue.emplace("bar"));
+    slassert(nt.reset());
+    slassert(!readable(nt.fd()));
+
+    std::string str;
+    slassert(queue.poll(str));
+    slassert("foo" == str);
+    slassert(queue.poll(str));
+    slassert("bar" == str);
+
+    // disarmed notifier is not signalled
+    slassert(queue.emplace("baz"));
+    slassert(!readable(nt.fd()));
+    slassert(queue.poll(str));
+
+    // re-armed
+    nt.arm();
+    slassert(queue.emplace("42"));
+    slassert(readable(nt.fd()));
+    slassert(nt.reset());
+    slassert(queue.poll(str));
+
+    // unblock wakes the loop
+    nt.arm();
+    queue.unblock();
+    slassert(readable(nt.fd()));
+}
+
+void test_spsc() {
+    sl::concurrent::spsc_waiting_queue<int, std::mutex, sl::concurrent::eventfd_notifier> queue{4};
+    auto& nt = queue.notifier();
+    slassert(queue.emplace(1));
+    slassert(readable(nt.fd()));
+    slassert(queue.emplace(2));
+    slassert(queue.emplace(3));
+    slassert(queue.emplace(4));
+    // full queue does not signal
+    nt.reset();
+    nt.arm();
+    slassert(!queue.emplace(5));
+    slassert(!readable(nt.fd()));
+    slassert(nt.is_armed());
+}
+
+void test_epoll_loop() {
+    const size_t count = 100000;
+    sl::concurrent::mpmc_blocking_queue<size_t, std::mutex, sl::concurrent::eventfd_notifier> queue;
+    auto& nt = queue.notifier();
+    int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    slassert(-1 != epfd);
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = nt.fd();
+    slassert(0 == ::epoll_ctl(epfd, EPOLL_CTL_ADD, nt.fd(), std::addressof(ev)));
+
+    std::thread producer([&queue] {
+        for (size_t i = 0; i < count; i++) {
+            queue.emplace(i);
+        }
+    });
+
+    size_t expected = 0;
+    size_t wakeups = 0;
+    while (expected < count) {
+        struct epoll_event got;
+        int res = ::epoll_wait(epfd, std::addressof(got), 1, 10000);
+        slassert(1 == res);
+        wakeups += 1;
+        nt.reset();
+        for (;;) {
+            queue.poll([&expected](size_t el) {
+                slassert(expected == el);
+                expected += 1;
+            });
+            nt.arm();
+            // element emplaced before arm did not signal the fd
+            if (queue.empty()) {
+                break;
+            }
+        }
+    }
+    producer.join();
+    ::close(epfd);
+    slassert(count == expected);
+    slassert(wakeups <= count);
+}
+
+int main() {
+    try {
+        test_coalescing();
+        test_spsc();
+        test_epoll_loop();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#else // !__linux__
+
+int main() {
+    // default notifier policy compiles on all platforms
+    sl::concurrent::mpmc_blocking_queue<int> queue;
+    queue.notifier().notify();
+    std::cout << "eventfd is not supported, test skipped" << std::endl;
+    return 0;
+}
+
+#endif // __linux__
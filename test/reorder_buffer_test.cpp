@@ -0,0 +1,140 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   reorder_buffer_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 6:00 AM
+ */
+
+#include "staticlib/concurrent/reorder_buffer.hpp"
+
+#include "staticlib/concurrent/mpmc_blocking_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+void test_reorder() {
+    sl::concurrent::reorder_buffer<std::string> rb{4};
+    slassert(4 == rb.window_size());
+    slassert(rb.put(2, "c"));
+    slassert(rb.put(1, "b"));
+    std::string el;
+    slassert(!rb.poll(el));
+    slassert(rb.put(0, "a"));
+    slassert(rb.poll(el));
+    slassert("a" == el);
+    std::vector<std::string> drained;
+    slassert(2 == rb.poll([&drained](std::string st) {
+        drained.emplace_back(std::move(st));
+    }));
+    slassert("b" == drained[0]);
+    slassert("c" == drained[1]);
+    slassert(3 == rb.next_sequence());
+    // already consumed
+    slassert(!rb.put(1, "x"));
+}
+
+void test_window() {
+    sl::concurrent::reorder_buffer<std::unique_ptr<int>> rb{2, 10};
+    slassert(rb.put(11, std::unique_ptr<int>(new int(11))));
+    // too far ahead
+    slassert(!rb.put(12, std::unique_ptr<int>(new int(12)), std::chrono::milliseconds(50)));
+    std::thread producer([&rb] {
+        slassert(rb.put(12, std::unique_ptr<int>(new int(12))));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    slassert(rb.put(10, std::unique_ptr<int>(new int(10))));
+    std::unique_ptr<int> el;
+    for (int i = 10; i <= 12; i++) {
+        slassert(rb.take(el));
+        slassert(i == *el);
+    }
+    producer.join();
+    // not consumed items are destroyed with the buffer
+    slassert(rb.put(14, std::unique_ptr<int>(new int(14))));
+}
+
+void test_take_wait() {
+    sl::concurrent::reorder_buffer<int> rb{8};
+    int el = 0;
+    auto start = std::chrono::steady_clock::now();
+    slassert(!rb.take(el, std::chrono::milliseconds(100)));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    slassert(elapsed.count() >= 100);
+    std::thread unblocker([&rb] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        rb.unblock();
+    });
+    slassert(!rb.take(el));
+    slassert(rb.is_unblocked());
+    unblocker.join();
+}
+
+void test_workers() {
+    const uint64_t count = 20000;
+    sl::concurrent::mpmc_blocking_queue<uint64_t> input;
+    sl::concurrent::reorder_buffer<uint64_t> rb{16};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < 4; i++) {
+        workers.emplace_back([&input, &rb] {
+            uint64_t seq = 0;
+            while (input.take(seq)) {
+                if (0 == seq % 7) {
+                    std::this_thread::yield();
+                }
+                slassert(rb.put(seq, seq * 3));
+            }
+        });
+    }
+    std::thread feeder([&input] {
+        for (uint64_t i = 0; i < count; i++) {
+            input.emplace(i);
+        }
+        input.unblock();
+    });
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t el = 0;
+        slassert(rb.take(el));
+        slassert(i * 3 == el);
+    }
+    feeder.join();
+    for (auto& th : workers) {
+        th.join();
+    }
+}
+
+int main() {
+    try {
+        test_reorder();
+        test_window();
+        test_take_wait();
+        test_workers();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   semaphore_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:50 PM
+ */
+
+#include "staticlib/concurrent/semaphore.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_single_thread() {
+    sl::concurrent::semaphore sem{2};
+    slassert(!sem.is_fair());
+    slassert(2 == sem.available_permits());
+    slassert(sem.try_acquire());
+    slassert(!sem.try_acquire(2));
+    slassert(sem.try_acquire());
+    slassert(!sem.try_acquire());
+    slassert(!sem.try_acquire_for(std::chrono::milliseconds(10)));
+    sem.release(3);
+    slassert(3 == sem.available_permits());
+    sem.acquire(3);
+    slassert(0 == sem.available_permits());
+    slassert(!sem.try_acquire_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(10), 2));
+}
+
+void test_limit(bool fair) {
+    sl::concurrent::semaphore sem{3, fair};
+    std::atomic<size_t> active{0};
+    std::atomic<size_t> max_active{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; i++) {
+        threads.emplace_back([&sem, &active, &max_active] {
+            for (size_t j = 0; j < 2000; j++) {
+                sem.acquire();
+                size_t cur = active.fetch_add(1) + 1;
+                size_t max = max_active.load();
+                while (cur > max && !max_active.compare_exchange_weak(max, cur)) { }
+                active.fetch_sub(1);
+                sem.release();
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(max_active.load() <= 3);
+    slassert(3 == sem.available_permits());
+}
+
+void test_bulk(bool fair) {
+    sl::concurrent::semaphore sem{0, fair};
+    std::atomic<size_t> acquired{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&sem, &acquired] {
+            sem.acquire(3);
+            acquired.fetch_add(1);
+        });
+    }
+    // single permits must wake bulk acquirers
+    for (size_t i = 0; i < 12; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        sem.release();
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(4 == acquired.load());
+    slassert(0 == sem.available_permits());
+}
+
+void test_fair_order() {
+    sl::concurrent::semaphore sem{0, true};
+    std::mutex mutex;
+    std::vector<size_t> order;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&sem, &mutex, &order, i] {
+            sem.acquire();
+            std::lock_guard<std::mutex> guard{mutex};
+            order.push_back(i);
+        });
+        // let the thread block before starting the next one
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    // blocked threads are not overtaken
+    slassert(!sem.try_acquire());
+    for (size_t i = 0; i < 4; i++) {
+        sem.release();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(4 == order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        slassert(i == order[i]);
+    }
+}
+
+void test_fair_timeout() {
+    sl::concurrent::semaphore sem{1, true};
+    std::atomic<bool> small_acquired{false};
+    std::thread big([&sem] {
+        slassert(!sem.try_acquire_for(std::chrono::milliseconds(100), 2));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread small([&sem, &small_acquired] {
+        sem.acquire();
+        small_acquired.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // small waiter is queued behind the big one
+    slassert(!small_acquired.load());
+    big.join();
+    small.join();
+    slassert(small_acquired.load());
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_limit(false);
+        test_limit(true);
+        test_bulk(false);
+        test_bulk(true);
+        test_fair_order();
+        test_fair_timeout();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   seqlock_cell_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:45 AM
+ */
+
+#include "staticlib/concurrent/seqlock_cell.hpp"
+
+#include <cstdint>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+class quote {
+public:
+    uint64_t bid;
+    uint64_t ask;
+    uint32_t seq;
+    char tag;
+};
+
+quote make_quote(uint32_t seq) {
+    quote res;
+    res.bid = seq * 10;
+    res.ask = seq * 10 + 1;
+    res.seq = seq;
+    res.tag = static_cast<char> ('a' + seq % 26);
+    return res;
+}
+
+void check_quote(const quote& qt) {
+    slassert(qt.bid == qt.seq * 10ULL);
+    slassert(qt.ask == qt.seq * 10ULL + 1);
+    slassert(qt.tag == static_cast<char> ('a' + qt.seq % 26));
+}
+
+void test_single_thread() {
+    sl::concurrent::seqlock_cell<quote> cell{make_quote(0)};
+    slassert(0 == cell.version());
+    check_quote(cell.load());
+    slassert(0 == cell.load().seq);
+    cell.store(make_quote(1));
+    cell.store(make_quote(2));
+    slassert(2 == cell.version());
+    quote qt;
+    slassert(cell.try_load(qt));
+    slassert(2 == qt.seq);
+    check_quote(qt);
+}
+
+void test_default_value() {
+    sl::concurrent::seqlock_cell<int, 3> cell;
+    slassert(0 == cell.load());
+    for (int i = 1; i <= 10; i++) {
+        cell.store(i);
+        slassert(i == cell.load());
+    }
+}
+
+template<size_t Slots>
+void test_concurrent() {
+    sl::concurrent::seqlock_cell<quote, Slots> cell{make_quote(0)};
+    const uint32_t writes = 100000;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 3; i++) {
+        readers.emplace_back([&cell, &stop] {
+            uint32_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                quote qt = cell.load();
+                check_quote(qt);
+                // values are never observed out of order
+                slassert(qt.seq >= last);
+                last = qt.seq;
+            }
+        });
+    }
+    for (uint32_t i = 1; i <= writes; i++) {
+        cell.store(make_quote(i));
+    }
+    stop.store(true);
+    for (auto& th : readers) {
+        th.join();
+    }
+    slassert(writes == cell.load().seq);
+    slassert(writes == cell.version());
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_default_value();
+        test_concurrent<1>();
+        test_concurrent<4>();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   spin_mutex_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:20 AM
+ */
+
+#include "staticlib/concurrent/spin_mutex.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_try_lock() {
+    sl::concurrent::spin_mutex mutex;
+    slassert(mutex.try_lock());
+    slassert(!mutex.try_lock());
+    mutex.unlock();
+    std::lock_guard<sl::concurrent::spin_mutex> guard{mutex};
+    slassert(!mutex.try_lock());
+}
+
+void test_exclusion() {
+    sl::concurrent::spin_mutex mutex;
+    // plain counter, data race would lose increments
+    size_t counter = 0;
+    const size_t threads_count = 8;
+    const size_t per_thread = 20000;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; i++) {
+        threads.emplace_back([&mutex, &counter, per_thread] {
+            for (size_t j = 0; j < per_thread; j++) {
+                std::lock_guard<sl::concurrent::spin_mutex> guard{mutex};
+                counter += 1;
+                if (0 == j % 1000) {
+                    // long critical section makes others block
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(threads_count * per_thread == counter);
+}
+
+void test_condition_variable() {
+    sl::concurrent::spin_mutex mutex;
+    std::condition_variable_any cv;
+    bool ready = false;
+    std::thread th([&mutex, &cv, &ready] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<sl::concurrent::spin_mutex> guard{mutex};
+        ready = true;
+        cv.notify_all();
+    });
+    std::unique_lock<sl::concurrent::spin_mutex> guard{mutex};
+    cv.wait(guard, [&ready] {
+        return ready;
+    });
+    slassert(ready);
+    guard.unlock();
+    th.join();
+}
+
+int main() {
+    try {
+        test_try_lock();
+        test_exclusion();
+        test_condition_variable();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -23,6 +23,8 @@
 
 #include "staticlib/concurrent/spsc_waiting_queue.hpp"
 
+#include "staticlib/concurrent/spin_mutex.hpp"
+
 #include <cstdlib>
 #include <chrono>
 #include <atomic>
@@ -44,6 +46,16 @@ public:
     }
 };
 
+template<typename T, size_t Size>
+class spin_queue_maker {
+public:
+    using queue_type = sl::concurrent::spsc_waiting_queue<T, sl::concurrent::spin_mutex>;
+
+    std::shared_ptr<queue_type> make_queue() {
+        return std::make_shared<queue_type>(Size);
+    }
+};
+
 int main() {
     try {
         test_correctness<queue_maker<std::string, 0xfffe>> ();
@@ -59,6 +71,9 @@ int main() {
         test_destructor_wrapped<queue_maker<dtor_checker, 4>> ();
         test_empty_full<queue_maker<int, 3>> ();
         
+        test_empty_full<spin_queue_maker<int, 3>>();
+        test_wait<spin_queue_maker<std::string, 1>>();
+
         test_wait<queue_maker<std::string, 1>>();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
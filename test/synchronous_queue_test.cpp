@@ -0,0 +1,184 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   synchronous_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 7:00 AM
+ */
+
+#include "staticlib/concurrent/synchronous_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+void test_handoff() {
+    sl::concurrent::synchronous_queue<std::string> queue;
+    std::string el;
+    // no counterpart
+    slassert(!queue.offer("foo"));
+    slassert(!queue.poll(el));
+    slassert(!queue.put("foo", std::chrono::milliseconds(50)));
+    slassert(!queue.take(el, std::chrono::milliseconds(50)));
+    slassert(0 == queue.waiting_producers());
+    slassert(0 == queue.waiting_consumers());
+    std::atomic<bool> taken{false};
+    std::thread producer([&queue, &taken] {
+        slassert(queue.put("bar"));
+        slassert(taken.load());
+    });
+    while (0 == queue.waiting_producers()) {
+        std::this_thread::yield();
+    }
+    taken.store(true);
+    slassert(queue.poll(el));
+    slassert("bar" == el);
+    producer.join();
+    std::thread consumer([&queue] {
+        std::string st;
+        slassert(queue.take(st));
+        slassert("baz" == st);
+    });
+    while (0 == queue.waiting_consumers()) {
+        std::this_thread::yield();
+    }
+    slassert(queue.offer("baz"));
+    consumer.join();
+}
+
+void test_unblock_waiters() {
+    sl::concurrent::synchronous_queue<int> queue;
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < 3; i++) {
+        consumers.emplace_back([&queue] {
+            int el = 0;
+            slassert(!queue.take(el));
+        });
+    }
+    while (3 != queue.waiting_consumers()) {
+        std::this_thread::yield();
+    }
+    queue.unblock();
+    for (auto& th : consumers) {
+        th.join();
+    }
+    slassert(!queue.put(1));
+}
+
+class throwing_move {
+public:
+    int value = 0;
+    bool fail = false;
+
+    throwing_move() { }
+
+    throwing_move(int value, bool fail) :
+    value(value),
+    fail(fail) { }
+
+    throwing_move(throwing_move&& other) :
+    value(other.value),
+    fail(other.fail) { }
+
+    throwing_move& operator=(throwing_move&& other) {
+        if (other.fail) {
+            throw std::runtime_error("move");
+        }
+        value = other.value;
+        return *this;
+    }
+};
+
+void test_throwing_move() {
+    sl::concurrent::synchronous_queue<throwing_move> queue;
+    int received = 0;
+    std::thread consumer([&queue, &received] {
+        throwing_move el;
+        slassert(queue.take(el));
+        received = el.value;
+    });
+    while (0 == queue.waiting_consumers()) {
+        std::this_thread::yield();
+    }
+    bool thrown = false;
+    try {
+        queue.put(throwing_move(1, true));
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // consumer is still waiting and gets the next element
+    slassert(1 == queue.waiting_consumers());
+    slassert(queue.put(throwing_move(42, false)));
+    consumer.join();
+    slassert(42 == received);
+}
+
+void test_concurrent() {
+    const int per_producer = 3000;
+    sl::concurrent::synchronous_queue<int> queue;
+    std::atomic<long> sum{0};
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < 2; i++) {
+        producers.emplace_back([&queue] {
+            for (int j = 1; j <= per_producer; j++) {
+                slassert(queue.put(j));
+            }
+        });
+    }
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < 3; i++) {
+        consumers.emplace_back([&queue, &sum] {
+            int el = 0;
+            while (queue.take(el)) {
+                sum.fetch_add(el);
+            }
+        });
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    while (3 != queue.waiting_consumers()) {
+        std::this_thread::yield();
+    }
+    queue.unblock();
+    for (auto& th : consumers) {
+        th.join();
+    }
+    slassert(static_cast<long> (per_producer) * (per_producer + 1) == sum.load());
+}
+
+int main() {
+    try {
+        test_handoff();
+        test_unblock_waiters();
+        test_throwing_move();
+        test_concurrent();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   task_queue_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:10 PM
+ */
+
+#include "staticlib/concurrent/task_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+const size_t PRODUCERS = 4;
+const size_t CONSUMERS = 4;
+const size_t ITERATIONS = 100000;
+
+void test_single_thread() {
+    sl::concurrent::task_queue<> queue{3};
+    slassert(4 == queue.max_size());
+    slassert(queue.empty());
+    int counter = 0;
+    for (size_t i = 0; i < 4; i++) {
+        bool res = queue.emplace([&counter, i] {
+            counter += static_cast<int>(i);
+        });
+        slassert(res);
+    }
+    slassert(4 == queue.size());
+    slassert(!queue.emplace([] {}));
+    sl::concurrent::inplace_task<> task;
+    while (queue.poll(task)) {
+        task();
+    }
+    slassert(6 == counter);
+    slassert(queue.empty());
+    slassert(!queue.poll(task));
+}
+
+void test_take_timeout() {
+    sl::concurrent::task_queue<> queue{4};
+    sl::concurrent::inplace_task<> task;
+    auto start = std::chrono::steady_clock::now();
+    slassert(!queue.take(task, std::chrono::milliseconds(50)));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    slassert(elapsed >= std::chrono::milliseconds(50));
+    slassert(!task);
+}
+
+void test_unblock() {
+    sl::concurrent::task_queue<> queue{4};
+    std::thread consumer([&queue] {
+        sl::concurrent::inplace_task<> task;
+        slassert(!queue.take(task));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.unblock();
+    consumer.join();
+    slassert(queue.is_unblocked());
+}
+
+class throwing_copy {
+public:
+    int* counter;
+
+    explicit throwing_copy(int* counter) :
+    counter(counter) { }
+
+    throwing_copy(const throwing_copy&) {
+        throw std::runtime_error("copy");
+    }
+
+    void operator()() {
+        *counter += 1;
+    }
+};
+
+void test_throwing_emplace() {
+    sl::concurrent::task_queue<> queue{4};
+    int counter = 0;
+    throwing_copy func{std::addressof(counter)};
+    bool thrown = false;
+    try {
+        queue.emplace(func);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    // failed slot does not stall the ring
+    slassert(queue.emplace([&counter] { counter += 10; }));
+    sl::concurrent::task_queue<>::value_type task;
+    slassert(queue.take(task, std::chrono::milliseconds(100)));
+    task();
+    slassert(10 == counter);
+    slassert(!queue.poll(task));
+}
+
+void test_mpmc() {
+    sl::concurrent::task_queue<> queue{256};
+    std::atomic<size_t> sum{0};
+    std::atomic<size_t> done{0};
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < CONSUMERS; i++) {
+        consumers.emplace_back([&queue] {
+            sl::concurrent::inplace_task<> task;
+            while (queue.take(task)) {
+                task();
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < PRODUCERS; i++) {
+        producers.emplace_back([&queue, &sum, &done] {
+            for (size_t j = 0; j < ITERATIONS; j++) {
+                auto fun = [&sum, &done, j] {
+                    sum.fetch_add(j, std::memory_order_relaxed);
+                    done.fetch_add(1, std::memory_order_release);
+                };
+                while (!queue.emplace(fun)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    while (done.load(std::memory_order_acquire) < PRODUCERS * ITERATIONS) {
+        std::this_thread::yield();
+    }
+    queue.unblock();
+    for (auto& th : consumers) {
+        th.join();
+    }
+    slassert(PRODUCERS * (ITERATIONS * (ITERATIONS - 1) / 2) == sum.load());
+    slassert(queue.empty());
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_take_timeout();
+        test_unblock();
+        test_throwing_emplace();
+        test_mpmc();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   thread_pool_executor_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:40 PM
+ */
+
+#include "staticlib/concurrent/thread_pool_executor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_submit() {
+    sl::concurrent::thread_pool_executor executor{4};
+    slassert(4 == executor.threads_count());
+    std::vector<sl::concurrent::task_future<size_t>> futures;
+    for (size_t i = 0; i < 1000; i++) {
+        futures.emplace_back(executor.submit([i] {
+            return i * 2;
+        }));
+    }
+    for (size_t i = 0; i < futures.size(); i++) {
+        slassert(futures[i].valid());
+        slassert(i * 2 == futures[i].get());
+        slassert(!futures[i].valid());
+    }
+}
+
+void test_void_and_move_only() {
+    sl::concurrent::thread_pool_executor executor{2};
+    std::atomic<int> shared{0};
+    auto fut = executor.submit([&shared] {
+        shared.fetch_add(1, std::memory_order_relaxed);
+    });
+    fut.get();
+    slassert(1 == shared.load(std::memory_order_relaxed));
+    auto fut_ptr = executor.submit([] {
+        return std::unique_ptr<std::string>(new std::string("foo"));
+    });
+    auto ptr = fut_ptr.get();
+    slassert("foo" == *ptr);
+}
+
+void test_exception() {
+    sl::concurrent::thread_pool_executor executor{1};
+    auto fut = executor.submit([]() -> int {
+        throw std::runtime_error("foo");
+    });
+    bool thrown = false;
+    try {
+        fut.get();
+    } catch (const std::runtime_error& e) {
+        thrown = true;
+        slassert(std::string("foo") == e.what());
+    }
+    slassert(thrown);
+}
+
+void test_wait_for() {
+    sl::concurrent::thread_pool_executor executor{1};
+    auto fut = executor.submit([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return 42;
+    });
+    slassert(!fut.wait_for(std::chrono::milliseconds(50)));
+    slassert(!fut.ready());
+    slassert(fut.wait_for(std::chrono::milliseconds(1000)));
+    slassert(fut.ready());
+    slassert(42 == fut.get());
+}
+
+void test_shutdown() {
+    std::atomic<int> shared{0};
+    sl::concurrent::thread_pool_executor executor{2};
+    for (size_t i = 0; i < 100; i++) {
+        bool accepted = executor.execute([&shared] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            shared.fetch_add(1, std::memory_order_relaxed);
+        });
+        slassert(accepted);
+    }
+    executor.shutdown();
+    // pending tasks are executed before shutdown
+    slassert(100 == shared.load(std::memory_order_relaxed));
+    slassert(executor.is_shut_down());
+    auto rejected = executor.submit([] {
+        return 42;
+    });
+    slassert(!rejected.valid());
+    slassert(!executor.execute([] {}));
+}
+
+void test_shutdown_from_task() {
+    sl::concurrent::thread_pool_executor executor{2};
+    auto fut = executor.submit([&executor] {
+        // does not join the calling worker
+        executor.shutdown();
+        return executor.is_shut_down();
+    });
+    slassert(fut.get());
+    slassert(!executor.execute([] {}));
+    // joins all the workers
+    executor.shutdown();
+}
+
+void test_reference_result() {
+    sl::concurrent::thread_pool_executor executor{1};
+    std::string str = "foo";
+    auto fut = executor.submit([&str]() -> std::string& {
+        return str;
+    });
+    std::string& ref = fut.get();
+    slassert(std::addressof(str) == std::addressof(ref));
+    auto moved = executor.submit([&str]() -> std::string&& {
+        return std::move(str);
+    });
+    std::string val = moved.get();
+    slassert("foo" == val);
+}
+
+void test_bounded() {
+    sl::concurrent::thread_pool_executor executor{1, 1};
+    std::atomic<bool> flag{false};
+    auto blocker = executor.submit([&flag] {
+        while (!flag.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+    // wait for the blocker to be taken from the queue
+    while (executor.queue_size() > 0) {
+        std::this_thread::yield();
+    }
+    auto queued = executor.submit([] {
+        return 1;
+    });
+    slassert(queued.valid());
+    auto rejected = executor.submit([] {
+        return 2;
+    });
+    slassert(!rejected.valid());
+    flag.store(true, std::memory_order_release);
+    blocker.get();
+    slassert(1 == queued.get());
+}
+
+int main() {
+    try {
+        test_submit();
+        test_void_and_move_only();
+        test_exception();
+        test_wait_for();
+        test_shutdown();
+        test_shutdown_from_task();
+        test_reference_result();
+        test_bounded();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   wait_group_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:10 PM
+ */
+
+#include "staticlib/concurrent/wait_group.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_single_thread() {
+    sl::concurrent::wait_group wg;
+    slassert(0 == wg.count());
+    wg.wait();
+    wg.add(3);
+    slassert(3 == wg.count());
+    wg.done();
+    wg.done();
+    slassert(1 == wg.count());
+    slassert(!wg.wait_for(std::chrono::milliseconds(10)));
+    wg.done();
+    slassert(0 == wg.count());
+    slassert(wg.wait_for(std::chrono::milliseconds(10)));
+}
+
+void test_workers() {
+    sl::concurrent::wait_group wg;
+    const size_t workers = 8;
+    std::atomic<size_t> finished{0};
+    std::vector<std::thread> threads;
+    wg.add(workers);
+    for (size_t i = 0; i < workers; i++) {
+        threads.emplace_back([&wg, &finished] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            finished.fetch_add(1);
+            wg.done();
+        });
+    }
+    wg.wait();
+    slassert(workers == finished.load());
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+void test_nested_add() {
+    // workers add more work before finishing their own
+    sl::concurrent::wait_group wg{4};
+    std::atomic<size_t> finished{0};
+    std::vector<std::thread> threads;
+    wg.add(4);
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&wg, &finished] {
+            wg.add(100);
+            for (size_t j = 0; j < 100; j++) {
+                finished.fetch_add(1);
+                wg.done();
+            }
+            finished.fetch_add(1);
+            wg.done();
+        });
+    }
+    slassert(wg.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(10)));
+    slassert(404 == finished.load());
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+void test_cross_thread_done() {
+    // counter incremented and decremented on different shards
+    sl::concurrent::wait_group wg{16};
+    const size_t tasks = 10000;
+    std::atomic<size_t> cursor{0};
+    std::vector<std::thread> threads;
+    wg.add(tasks);
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&wg, &cursor, tasks] {
+            while (cursor.fetch_add(1) < tasks) {
+                wg.done();
+            }
+        });
+    }
+    wg.wait();
+    slassert(cursor.load() >= tasks);
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+void test_destroy_after_wait() {
+    for (size_t i = 0; i < 200; i++) {
+        auto wg = std::make_shared<sl::concurrent::wait_group>();
+        wg->add(2);
+        auto wg_ptr = wg.get();
+        std::thread th1([wg_ptr] { wg_ptr->done(); });
+        std::thread th2([wg_ptr] { wg_ptr->done(); });
+        wg->wait();
+        wg.reset();
+        th1.join();
+        th2.join();
+    }
+}
+
+void test_parked_waiters() {
+    // updates while waiters are parked, then again after they leave
+    sl::concurrent::wait_group wg{8};
+    for (size_t round = 0; round < 20; round++) {
+        std::atomic<size_t> finished{0};
+        std::atomic<size_t> woken{0};
+        std::vector<std::thread> waiters;
+        wg.add(4);
+        for (size_t i = 0; i < 3; i++) {
+            waiters.emplace_back([&wg, &finished, &woken] {
+                wg.wait();
+                slassert(404 == finished.load());
+                woken.fetch_add(1);
+            });
+        }
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < 4; i++) {
+            workers.emplace_back([&wg, &finished] {
+                for (size_t j = 0; j < 100; j++) {
+                    wg.add();
+                    finished.fetch_add(1);
+                    wg.done();
+                }
+                finished.fetch_add(1);
+                wg.done();
+            });
+        }
+        for (auto& th : workers) {
+            th.join();
+        }
+        for (auto& th : waiters) {
+            th.join();
+        }
+        slassert(3 == woken.load());
+        slassert(0 == wg.count());
+    }
+}
+
+void test_concurrent_waiters() {
+    // waiters drain the shards concurrently with in-flight 'done' calls
+    for (size_t round = 0; round < 200; round++) {
+        sl::concurrent::wait_group wg{8};
+        const size_t tasks = 64;
+        std::atomic<size_t> finished{0};
+        std::atomic<bool> failed{false};
+        wg.add(tasks);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < 4; i++) {
+            workers.emplace_back([&wg, &finished, tasks] {
+                for (size_t j = 0; j < tasks / 4; j++) {
+                    finished.fetch_add(1);
+                    wg.done();
+                }
+            });
+        }
+        std::vector<std::thread> waiters;
+        for (size_t i = 0; i < 4; i++) {
+            waiters.emplace_back([&wg, &finished, &failed, tasks] {
+                wg.wait();
+                if (tasks != finished.load()) {
+                    failed.store(true);
+                }
+            });
+        }
+        for (auto& th : waiters) {
+            th.join();
+        }
+        for (auto& th : workers) {
+            th.join();
+        }
+        slassert(!failed.load());
+    }
+}
+
+int main() {
+    try {
+        test_single_thread();
+        test_workers();
+        test_nested_add();
+        test_cross_thread_done();
+        test_destroy_after_wait();
+        test_parked_waiters();
+        test_concurrent_waiters();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2017, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   work_stealing_deque_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 12:31 PM
+ */
+
+#include "staticlib/concurrent/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config/assert.hpp"
+
+void test_owner() {
+    sl::concurrent::work_stealing_deque<int> deque{2};
+    slassert(deque.empty());
+    for (int i = 0; i < 100; i++) {
+        deque.push(i);
+    }
+    slassert(100 == deque.size());
+    int el = -1;
+    // LIFO for owner
+    slassert(deque.pop(el));
+    slassert(99 == el);
+    // FIFO for thieves
+    slassert(deque.steal(el));
+    slassert(0 == el);
+    for (int i = 98; i > 0; i--) {
+        slassert(deque.pop(el));
+        slassert(i == el);
+    }
+    slassert(!deque.pop(el));
+    slassert(!deque.steal(el));
+    slassert(deque.empty());
+}
+
+void test_steal() {
+    const size_t count = 1 << 16;
+    sl::concurrent::work_stealing_deque<size_t> deque{};
+    std::vector<std::atomic<int>> seen(count);
+    for (auto& s : seen) {
+        s.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<bool> done{false};
+    auto thief = [&] {
+        size_t el = 0;
+        while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+            if (deque.steal(el)) {
+                seen[el].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+    std::thread thief1(thief);
+    std::thread thief2(thief);
+    for (size_t i = 0; i < count; i++) {
+        deque.push(i);
+        if (0 == i % 3) {
+            size_t el = 0;
+            if (deque.pop(el)) {
+                seen[el].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    size_t el = 0;
+    while (deque.pop(el)) {
+        seen[el].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    thief1.join();
+    thief2.join();
+    for (auto& s : seen) {
+        slassert(1 == s.load(std::memory_order_relaxed));
+    }
+}
+
+int main() {
+    try {
+        test_owner();
+        test_steal();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}